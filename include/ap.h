@@ -8,6 +8,10 @@
 
 #include "./user.h"
 #include "./packet.h"
+#include "./packet_queue.h"
+#include "./latency_histogram.h"
+#include "./protocol_params.h"
+#include "./mobility.h"
 class AccessPoint {
 protected:
     int id;
@@ -17,10 +21,51 @@ protected:
     std::vector<double> latencies;
     mutable std::mutex mutex;
 
+    ProtocolParams params;
+    QueueConfig queueConfig;
+    std::vector<PacketQueue> downlinkQueues; // one per station, parallel to users
+    size_t downlinkCursor;
+    bool downlinkActive;
+    LatencyHistogram uplinkDelay;
+    LatencyHistogram downlinkDelay;
+    std::unique_ptr<MobilityModel> mobility;
+
+    // Pull the next packet from a station's queue at time `now`,
+    // recording how long it waited. Returns nullptr if nothing is queued.
+    // Templated on the station type so it inlines into the policy loops.
+    template <typename UserT>
+    std::unique_ptr<Packet> dequeueUplink(UserT& user, double now) {
+        PacketQueue& queue = user.getUplinkQueue();
+        if (queue.arrivalsDue(now)) {
+            queue.offer(now, user.getPacketSize(), user.getId(), 0); // data to the AP
+        }
+
+        QueuedPacket head;
+        if (!queue.dequeue(now, head)) return nullptr;
+        uplinkDelay.record(now - head.enqueueTime);
+        return std::make_unique<Packet>(head.size, head.sourceId, head.destinationId);
+    }
+    std::unique_ptr<Packet> dequeueDownlink(size_t station, double now);
+    // Round-robin over the downlink queues of reachable stations for the
+    // next packet to send; `station` receives the queue it came from
+    std::unique_ptr<Packet> nextDownlinkPacket(double now, size_t& station);
+    bool hasDownlinkTraffic() const;
+    // Move stations up to `now` and push changed links to the users
+    void advanceMobility(double now);
+    // Airtime of a packet on a station's current link
+    double airtime(const Packet& packet, const User& user, double bandwidthMhz) const;
+
 public:
     AccessPoint(int apId, double bw = 20);
 
+    void setProtocolParams(const ProtocolParams& p);
+    // Applies to users added afterwards
+    void setQueueConfig(const QueueConfig& config);
     virtual void addUser(std::unique_ptr<User> user);
+    // Per-station offered load, overriding the queue configuration's rates
+    void addUser(std::unique_ptr<User> user, double uplinkRate, double downlinkRate);
+    // One model slot per user, in the order they were added
+    void setMobility(std::unique_ptr<MobilityModel> model);
     virtual void simulateTransmission() = 0;
     virtual double computeThroughput() = 0;
     virtual std::pair<double, double> computeLatency() = 0;
@@ -29,6 +74,8 @@ public:
     const std::vector<std::unique_ptr<Packet>>& getTransmittedPackets() const;
     int getId() const;
     const std::vector<std::unique_ptr<User>>& getUsers() const;
+    const LatencyHistogram& getUplinkQueueingDelay() const;
+    const LatencyHistogram& getDownlinkQueueingDelay() const;
     virtual ~AccessPoint() = default;
 };
 
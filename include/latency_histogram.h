@@ -0,0 +1,36 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Log-linear histogram in the style of HdrHistogram. Values are recorded
+// in microseconds; each power-of-two range is split into 64 linear
+// sub-buckets, so any percentile is accurate to within ~1.6%.
+// Recording never allocates.
+class LatencyHistogram {
+private:
+    static const int SUB_BUCKET_BITS = 7;
+    std::vector<uint64_t> counts;
+    uint64_t totalCount;
+    uint64_t maxValue;
+    double sum;
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(size_t index);
+
+public:
+    LatencyHistogram();
+
+    void record(double latencyMs);
+    void merge(const LatencyHistogram& other);
+
+    // p in [0, 100]; returns milliseconds
+    double percentile(double p) const;
+    double mean() const;
+    double max() const;
+    uint64_t count() const;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,14 @@
+#ifndef LINK_H
+#define LINK_H
+
+// Radio link between a station and its AP. The defaults describe an ideal
+// link that uses whatever MCS the AP is configured with.
+struct Link {
+    bool usable = true;         // SNR high enough for the lowest MCS
+    bool beamformable = true;   // SNR high enough for MU-MIMO steering
+    double snrDb = 0.0;
+    int modulationBits = 0;     // 0 = the AP's configured modulation
+    double codingRate = 0.0;
+};
+
+#endif // LINK_H
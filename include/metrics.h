@@ -0,0 +1,84 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Process-wide progress counters. Simulation loops publish into them with
+// relaxed atomics, in batches; nothing in the loops ever waits on a reader.
+struct SimulationMetrics {
+    std::atomic<uint64_t> scenariosPlanned{0};
+    std::atomic<uint64_t> scenariosCompleted{0}; // protocol runs, including cache hits
+    std::atomic<uint64_t> activeRuns{0};
+    std::atomic<uint64_t> events{0};             // transmissions simulated
+    std::atomic<uint64_t> simulatedMicros{0};    // simulated time covered
+    std::atomic<int64_t> lastProgressNanos{0};   // steady_clock time of the last publish
+};
+
+SimulationMetrics& simulationMetrics();
+
+// Tracks one simulation run locally and publishes its progress once
+// EVENTS_PER_PUBLISH transmissions have accumulated. A round can hold any
+// number of transmissions (an MU-MIMO round sounds every station), so
+// counting events keeps the publish rate steady in wall-clock terms;
+// ROUNDS_PER_PUBLISH covers stretches of rounds that transmit nothing.
+class RunProgress {
+private:
+    static const size_t EVENTS_PER_PUBLISH = 4096;
+    static const unsigned ROUNDS_PER_PUBLISH = 4096;
+    unsigned rounds = 0;
+    size_t publishedEvents = 0;
+    uint64_t publishedMicros = 0;
+
+public:
+    RunProgress();
+    ~RunProgress();
+    RunProgress(const RunProgress&) = delete;
+    RunProgress& operator=(const RunProgress&) = delete;
+
+    // Called once per round with the run's totals so far
+    void update(size_t totalEvents, double now) {
+        if (totalEvents - publishedEvents >= EVENTS_PER_PUBLISH || ++rounds >= ROUNDS_PER_PUBLISH) {
+            publish(totalEvents, now);
+        }
+    }
+    // Push everything up to these totals; call once more when the run ends
+    void publish(size_t totalEvents, double now);
+};
+
+// Background thread that rewrites a Prometheus text-format file with the
+// current counters, derived rates and resident memory every interval.
+// The file is replaced atomically, so readers never see a partial write.
+class MetricsExporter {
+private:
+    std::string path;
+    double intervalSeconds;
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    uint64_t lastEvents = 0;
+    uint64_t lastSimulatedMicros = 0;
+    int64_t lastSnapshotNanos = 0;
+    int64_t startNanos = 0;
+
+    void run();
+    void writeSnapshot();
+
+public:
+    MetricsExporter(const std::string& file, double interval = 1.0);
+    ~MetricsExporter(); // writes a final snapshot
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+// Resident set size of this process, from /proc/self/statm; 0 if unavailable
+uint64_t residentMemoryBytes();
+
+#endif // METRICS_H
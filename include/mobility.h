@@ -0,0 +1,104 @@
+#ifndef MOBILITY_H
+#define MOBILITY_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "./link.h"
+
+enum class MobilityPattern {
+    Static,
+    Linear,         // constant heading, reflecting off the area edges
+    RandomWaypoint  // walk to a random point, then pick another
+};
+
+struct MobilityConfig {
+    bool enabled = false;
+    MobilityPattern pattern = MobilityPattern::Static;
+    double areaWidth = 100.0;           // m
+    double areaHeight = 100.0;          // m
+    double apX = 50.0;                  // m
+    double apY = 50.0;                  // m
+    double speed = 1.4;                 // m/s
+    double updateInterval = 100.0;      // ms between position updates
+    double rateThreshold = 1.0;         // m moved before a link is re-evaluated
+    double gridCellSize = 10.0;         // m
+    double interferenceRadius = 5.0;    // m
+    double interferenceFactor = 0.1;    // noise rise per neighbour, linear
+    double txPower = 20.0;              // dBm
+    double referenceLoss = 46.0;        // dB at 1 m
+    double pathLossExponent = 3.5;
+    double noiseFloor = -92.0;          // dBm
+    double beamformingSnr = 15.0;       // dB
+    unsigned seed = 1;
+};
+
+// Station positions, movement and the resulting per-station link quality.
+// Stations are bucketed in a uniform grid so neighbour lookups only visit
+// nearby cells, and a station's link is only recomputed once it has moved
+// more than rateThreshold since the last evaluation, or once a station
+// that changed cell or was recomputed itself may have entered or left its
+// interference radius.
+class MobilityModel {
+private:
+    MobilityConfig config;
+    std::mt19937 rng;
+
+    // Per-station state, indexed by station slot
+    std::vector<double> x, y;
+    std::vector<double> vx, vy;          // m/ms
+    std::vector<double> targetX, targetY;
+    std::vector<double> rateX, rateY;    // where the link was last evaluated
+    std::vector<Link> links;
+
+    // Spatial grid
+    int columns, rows;
+    std::vector<std::vector<uint32_t>> cells;
+    std::vector<uint32_t> cellOf;
+    std::vector<uint32_t> slotInCell;
+
+    // A station that changed grid cell during one update step
+    struct CellCrossing {
+        uint32_t station;
+        double fromX, fromY;
+    };
+
+    double lastUpdate;
+    double nextUpdate;
+    std::vector<size_t> changed;
+    std::vector<uint8_t> stale;          // link to recompute at this update
+    std::vector<CellCrossing> crossings;
+
+    uint32_t cellIndex(double px, double py) const;
+    void insertIntoGrid(size_t station);
+    void removeFromGrid(size_t station);
+    void moveStation(size_t station, double dtMs);
+    void pickWaypoint(size_t station);
+    void evaluateLink(size_t station);
+    // Stations other than `station` within `radius` metres of (px, py)
+    template <typename Visit>
+    void forEachNeighbour(size_t station, double px, double py, double radius, Visit visit) const;
+    // Flag every station whose crowd `station` may have joined or left at (px, py)
+    void markNeighboursStale(size_t station, double px, double py);
+
+public:
+    MobilityModel(const MobilityConfig& cfg, size_t stationCount);
+
+    // Override the random initial position of a station
+    void placeStation(size_t station, double px, double py);
+    // Evaluate every link; call once placement is done
+    void evaluateAllLinks();
+    // Move stations up to `now`, re-evaluating links that moved far enough
+    void advanceTo(double now);
+
+    double nextUpdateTime() const;
+    const std::vector<size_t>& changedStations() const;
+    const Link& link(size_t station) const;
+    double getX(size_t station) const;
+    double getY(size_t station) const;
+    size_t size() const;
+    // Stations within `radius` metres of `station`, excluding itself
+    void neighbours(size_t station, double radius, std::vector<size_t>& out) const;
+};
+
+#endif // MOBILITY_H
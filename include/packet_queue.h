@@ -0,0 +1,76 @@
+#ifndef PACKET_QUEUE_H
+#define PACKET_QUEUE_H
+
+#include <cstddef>
+#include "./ring_buffer.h"
+
+// Arrival rate meaning "the station always has a full buffer"
+const double SATURATED = -1.0;
+
+enum class AqmMode {
+    DropTail,
+    CoDel
+};
+
+struct QueueConfig {
+    size_t capacity = 64;               // packets
+    AqmMode aqm = AqmMode::DropTail;
+    double codelTarget = 5.0;           // ms
+    double codelInterval = 100.0;       // ms
+    double uplinkRate = SATURATED;      // packets per ms per station
+    double downlinkRate = 0.0;          // packets per ms per station, 0 = no downlink traffic
+};
+
+struct QueuedPacket {
+    int size;
+    int sourceId;
+    int destinationId;
+    double enqueueTime;
+};
+
+// Bounded FIFO for one station and direction, fed by a constant-rate (or
+// saturated) source and optionally managed by CoDel (RFC 8289). Serving
+// each station's queue in turn with CoDel on every queue gives FQ-CoDel
+// behaviour at station granularity.
+class PacketQueue {
+private:
+    RingBuffer<QueuedPacket> buffer;
+    AqmMode aqm;
+    double target;
+    double interval;
+    double arrivalRate;
+    double nextArrival;
+
+    // CoDel state
+    bool dropping;
+    double firstAboveTime;
+    double dropNext;
+    unsigned count;
+    unsigned lastCount;
+
+    long enqueued;
+    long tailDrops;
+    long aqmDrops;
+
+    bool codelOkToDrop(const QueuedPacket& head, double now);
+    double controlLaw(double t) const;
+
+public:
+    PacketQueue(const QueueConfig& config = QueueConfig(), double rate = SATURATED);
+
+    // True if the source has packets to hand over by `now`
+    bool arrivalsDue(double now) const;
+    // Enqueue everything the source produced up to `now`, tail-dropping on overflow
+    void offer(double now, int size, int src, int dest);
+    // Pop the next packet to send; CoDel may discard packets from the head first
+    bool dequeue(double now, QueuedPacket& out);
+    // Earliest time a packet can be dequeued, or a negative value if never
+    double readyTime(double now) const;
+
+    size_t size() const;
+    long getEnqueued() const;
+    long getTailDrops() const;
+    long getAqmDrops() const;
+};
+
+#endif // PACKET_QUEUE_H
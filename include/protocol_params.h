@@ -0,0 +1,20 @@
+#ifndef PROTOCOL_PARAMS_H
+#define PROTOCOL_PARAMS_H
+
+#include <vector>
+
+// Model knobs shared by every access point; defaults match the
+// original hard-coded WiFi 4/5/6 setup
+struct ProtocolParams {
+    double duration = 1000.0;                      // ms
+    double bandwidth = 20.0;                       // MHz
+    int modulationBits = 8;                        // 256-QAM
+    double codingRate = 5.0 / 6.0;
+    int packetSize = 1024;                         // bytes
+    int csiSize = 200;                             // bytes, WiFi 5 channel state report
+    double parallelTime = 15.0;                    // ms, WiFi 5 MU-MIMO window
+    double allocationTime = 5.0;                   // ms, WiFi 6 OFDMA window
+    std::vector<int> subChannelSizes = {2, 4, 10}; // MHz, WiFi 6 resource units
+};
+
+#endif // PROTOCOL_PARAMS_H
@@ -0,0 +1,21 @@
+#ifndef RESULT_H
+#define RESULT_H
+
+#include <cstddef>
+
+// Metrics of one protocol at one user count
+struct ProtocolResult {
+    double throughput, avgLatency, maxLatency, queueP50, queueP99;
+    size_t packets; // transmissions simulated
+};
+
+struct Result {
+    int users;
+    double wifi4Throughput, wifi5Throughput, wifi6Throughput;        // Mbps
+    double wifi4AvgLatency, wifi5AvgLatency, wifi6AvgLatency;        // ms
+    double wifi4MaxLatency, wifi5MaxLatency, wifi6MaxLatency;        // ms
+    double wifi4QueueP50, wifi5QueueP50, wifi6QueueP50;              // ms, queueing delay
+    double wifi4QueueP99, wifi5QueueP99, wifi6QueueP99;              // ms, queueing delay
+};
+
+#endif // RESULT_H
@@ -0,0 +1,36 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include "./result.h"
+
+// Part of every cache key. Bump whenever a model change alters results,
+// so stale entries are simply never looked up again.
+const std::string SIMULATOR_VERSION = "1.5";
+
+// On-disk, content-addressed store of per-protocol simulation results.
+// Each entry lives in its own file named after the key; a flat index of
+// keys is loaded once at startup so lookups never scan the entries.
+class ResultCache {
+private:
+    std::string directory;
+    std::unordered_set<uint64_t> index;
+
+    std::string entryPath(uint64_t key) const;
+    std::string indexPath() const;
+    void loadIndex();
+
+public:
+    ResultCache(const std::string& dir);
+
+    // Hash of the full scenario description plus SIMULATOR_VERSION
+    static uint64_t makeKey(const std::string& config);
+
+    bool lookup(uint64_t key, ProtocolResult& result) const;
+    void store(uint64_t key, const ProtocolResult& result);
+    size_t size() const;
+};
+
+#endif // RESULT_CACHE_H
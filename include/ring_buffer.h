@@ -0,0 +1,41 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+// Fixed-capacity FIFO. Storage is allocated once up front, so push/pop
+// never touch the heap.
+template <typename T>
+class RingBuffer {
+private:
+    std::vector<T> slots;
+    size_t head;
+    size_t count;
+
+public:
+    explicit RingBuffer(size_t capacity = 0) : slots(capacity), head(0), count(0) {}
+
+    bool push(const T& value) {
+        if (full()) return false;
+        size_t tail = head + count;
+        if (tail >= slots.size()) tail -= slots.size();
+        slots[tail] = value;
+        ++count;
+        return true;
+    }
+
+    const T& front() const { return slots[head]; }
+
+    void pop() {
+        if (++head == slots.size()) head = 0;
+        --count;
+    }
+
+    size_t size() const { return count; }
+    size_t capacity() const { return slots.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == slots.size(); }
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,39 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <string>
+#include <vector>
+#include "./mobility.h"
+#include "./packet_queue.h"
+#include "./protocol_params.h"
+
+// Everything the simulator needs to run a sweep. The defaults reproduce the
+// built-in 1/10/100-user comparison of WiFi 4, 5 and 6.
+struct ScenarioConfig {
+    ProtocolParams params;
+    QueueConfig queue;
+    MobilityConfig mobility;
+    std::vector<int> userCounts = {1, 10, 100};
+    std::vector<std::string> accessPoints = {"wifi4", "wifi5", "wifi6"};
+    std::string stationTable; // optional binary sidecar with per-station parameters
+    unsigned seed = 1;        // station i draws its random stream from seed + i
+};
+
+// Reads an INI-style scenario file ([section] headers, key = value lines,
+// '#' comments) on top of the defaults already in `config`
+bool loadScenario(const std::string& path, ScenarioConfig& config, std::string& error);
+
+// Canonical text form of every setting that affects one access point's
+// results: the shared settings plus that protocol's own, for cache keys
+std::string describeScenario(const ScenarioConfig& config, const std::string& accessPoint);
+
+// Strict field parsers shared by the scenario and station-table readers:
+// the whole text must be a finite number in range, otherwise they return false.
+// Callers trim surrounding whitespace first.
+std::string trim(const std::string& text);
+bool parseDouble(const std::string& text, double& value);
+bool parseInt(const std::string& text, int& value);
+// A non-negative rate in packets per ms, or "saturated"
+bool parseRate(const std::string& text, double& value);
+
+#endif // SCENARIO_H
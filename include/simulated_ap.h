@@ -0,0 +1,147 @@
+#ifndef SIMULATED_AP_H
+#define SIMULATED_AP_H
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "./ap.h"
+#include "./metrics.h"
+#include "./packet.h"
+
+// Channel share a scheduler policy hands to one station for a round
+template <typename UserT>
+struct Grant {
+    UserT* user;
+    double bandwidth; // MHz
+};
+
+// Access point assembled from compile-time policies:
+//   AccessPolicy    - how the medium is won each round; advances time
+//   SchedulerPolicy - which stations send in a round, and on how much bandwidth
+//   StatsPolicy     - how throughput and latency are derived afterwards
+// Policies are friends so they can drive the queues and packet log directly;
+// a whole round inlines into simulateTransmission with no virtual dispatch
+// on the AP side.
+template <typename AccessPolicy, typename SchedulerPolicy, typename StatsPolicy>
+class SimulatedAP : public AccessPoint {
+public:
+    using UserType = typename AccessPolicy::UserType;
+
+protected:
+    AccessPolicy access;
+    SchedulerPolicy scheduler;
+    StatsPolicy stats;
+    std::vector<UserType*> stations;
+    std::vector<Grant<UserType>> grants;
+    double currentTime;
+
+    friend AccessPolicy;
+    friend SchedulerPolicy;
+    friend StatsPolicy;
+
+    void schedule() {
+        grants.clear();
+        scheduler.schedule(stations, params, grants);
+    }
+
+    // Every granted station sends in parallel for the whole window: one
+    // packet spanning it, or, when the scheduler hands out channel shares,
+    // packets back to back on its share for as long as they fit. The AP
+    // serves each station's downlink queue alongside.
+    void transmitWindow(double start, double window) {
+        const double end = start + window + 1e-9;
+        for (auto& grant : grants) {
+            // A station whose rate on this share cannot fit a packet in the window waits
+            double txTime = airtime(Packet(grant.user->getPacketSize()), *grant.user, grant.bandwidth);
+            if (txTime > window) continue;
+            if (!SchedulerPolicy::FILLS_WINDOW) {
+                auto packet = dequeueUplink(*grant.user, start);
+                if (!packet) continue;
+                packet->setTransmissionTime(start, start + window);
+                grant.user->addTransmittedPacket(*packet);
+                transmittedPackets.push_back(std::move(packet));
+                continue;
+            }
+            for (double now = start; now + txTime <= end; now += txTime) {
+                auto packet = dequeueUplink(*grant.user, now);
+                if (!packet) break;
+                packet->setTransmissionTime(now, now + txTime);
+                grant.user->addTransmittedPacket(*packet);
+                transmittedPackets.push_back(std::move(packet));
+            }
+        }
+        if (hasDownlinkTraffic()) {
+            for (size_t station = 0; station < downlinkQueues.size(); ++station) {
+                if (!users[station]->getLink().usable) continue;
+                if (auto packet = dequeueDownlink(station, start)) {
+                    packet->setTransmissionTime(start, start + window);
+                    transmittedPackets.push_back(std::move(packet));
+                }
+            }
+        }
+    }
+
+public:
+    SimulatedAP(int apId) : AccessPoint(apId), currentTime(0.0) {}
+
+    void simulateTransmission() override {
+        currentTime = 0.0;
+        access.reset();
+        scheduler.reset();
+
+        stations.clear();
+        for (auto& user : users) {
+            if (auto station = dynamic_cast<UserType*>(user.get())) {
+                stations.push_back(station);
+            }
+        }
+        grants.reserve(stations.size());
+
+        RunProgress progress;
+        while (currentTime < params.duration) {
+            if (mobility) advanceMobility(currentTime);
+            currentTime = access.runRound(*this, currentTime);
+            progress.update(transmittedPackets.size(), std::min(currentTime, params.duration));
+        }
+        progress.publish(transmittedPackets.size(), params.duration);
+    }
+
+    // When nothing can be scheduled, the next instant that may change that
+    double idleUntil(double now) const {
+        if (mobility && mobility->nextUpdateTime() < params.duration) {
+            return std::max(now, mobility->nextUpdateTime());
+        }
+        return params.duration;
+    }
+
+    // Earliest instant a reachable station, or the AP on its behalf, has a
+    // packet to send; `now` if one is waiting, else the next link change
+    double nextReadyTime(double now) const {
+        double next = idleUntil(now);
+        for (size_t station = 0; station < users.size() && next > now; ++station) {
+            if (!users[station]->getLink().usable) continue;
+            double ready = users[station]->getUplinkQueue().readyTime(now);
+            if (ready >= 0.0) next = std::min(next, ready);
+            if (downlinkActive) {
+                ready = downlinkQueues[station].readyTime(now);
+                if (ready >= 0.0) next = std::min(next, ready);
+            }
+        }
+        return next;
+    }
+
+    double computeThroughput() override { return stats.throughput(*this); }
+    std::pair<double, double> computeLatency() override { return stats.latency(*this); }
+};
+
+// Delivered bits over the simulated duration, in Mbps
+inline double deliveredThroughput(const AccessPoint& ap, double durationMs) {
+    double totalBits = 0.0;
+    for (const auto& packet : ap.getTransmittedPackets()) {
+        totalBits += packet->getSize() * 8;
+    }
+    return totalBits / (durationMs * 1000.0);
+}
+
+#endif // SIMULATED_AP_H
@@ -0,0 +1,24 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include "./ap.h"
+#include "./result.h"
+#include "./scenario.h"
+#include "./station_table.h"
+
+// Median and 99th percentile queueing delay over both directions
+std::pair<double, double> queueingDelay(const AccessPoint& ap);
+
+// Run one access point ("wifi4", "wifi5" or "wifi6") for one user count;
+// stations with an entry in the table take their packet size and offered
+// load from it. Unknown names yield an all-zero result.
+ProtocolResult runProtocol(const std::string& name, const ScenarioConfig& config, const StationTable& stations,
+                           int numUsers);
+
+// Copy one protocol's metrics into its columns of a result row
+void storeProtocolResult(Result& result, const std::string& name, const ProtocolResult& r);
+
+#endif // SIMULATION_H
@@ -0,0 +1,46 @@
+#ifndef STATION_TABLE_H
+#define STATION_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One station's parameters as stored in the binary sidecar
+struct StationRecord {
+    int32_t id;
+    int32_t packetSize;  // bytes, 0 = scenario default
+    float uplinkRate;    // packets per ms, SATURATED or 0 allowed
+    float downlinkRate;  // packets per ms
+    float x;             // m, NaN = random placement
+    float y;             // m
+};
+
+// Read-only view of a station table file. The file is memory-mapped, so
+// opening it costs the same for ten stations or ten million; pages are
+// faulted in only as records are read.
+class StationTable {
+private:
+    void* mapping;
+    size_t mappingSize;
+    const StationRecord* records;
+    size_t count;
+
+    void close();
+
+public:
+    StationTable();
+    ~StationTable();
+    StationTable(const StationTable&) = delete;
+    StationTable& operator=(const StationTable&) = delete;
+
+    bool open(const std::string& path, std::string& error);
+    size_t size() const;
+    const StationRecord& operator[](size_t index) const;
+};
+
+bool writeStationTable(const std::string& path, const std::vector<StationRecord>& stations, std::string& error);
+// Text form: one "id, packet_size, uplink_rate, downlink_rate[, x, y]" line per station
+bool convertStationTable(const std::string& csvPath, const std::string& binaryPath, std::string& error);
+
+#endif // STATION_TABLE_H
@@ -4,17 +4,28 @@
 #include <memory>
 #include <random>
 #include "./packet.h"
+#include "./packet_queue.h"
+#include "./link.h"
 class User {
 protected:
     int id;
+    int packetSize; // bytes
     std::mt19937 rng;
+    PacketQueue uplinkQueue;
+    Link link;
 
 public:
-    User(int userId);
+    User(int userId, int size = 1024);
 
     virtual std::unique_ptr<Packet> createPacket() = 0;
     virtual bool canTransmit() = 0;
     int getId() const;
+    int getPacketSize() const;
+    PacketQueue& getUplinkQueue();
+    // Restart the station's random stream, for reproducible runs
+    void seed(unsigned value);
+    const Link& getLink() const;
+    void setLink(const Link& l);
     virtual ~User() = default;
 };
 
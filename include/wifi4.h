@@ -10,6 +10,7 @@
 #include <mutex>
 #include "./ap.h"
 #include "./packet.h"
+#include "./simulated_ap.h"
 #include "./user.h"
 
 class WiFi4User : public User {
@@ -21,7 +22,7 @@ private:
     std::vector<Packet> transmittedPackets;
 
 public:
-    WiFi4User(int userId);
+    WiFi4User(int userId, int size = 1024);
 
     std::unique_ptr<Packet> createPacket() override;
     bool canTransmit() override;
@@ -36,21 +37,138 @@ public:
     void addTransmittedPacket(const Packet& packet);
 };
 
-class WiFi4AccessPoint : public AccessPoint {
+// Stations are served one at a time on the full channel
+class SequentialScheduler {
+public:
+    // A grant is one spatial stream: one packet per parallel window
+    static constexpr bool FILLS_WINDOW = false;
+
+    void reset() {}
+
+    template <typename UserT>
+    void schedule(const std::vector<UserT*>& stations, const ProtocolParams& params, std::vector<Grant<UserT>>& grants) {
+        for (auto user : stations) {
+            if (user->canTransmit() && user->getLink().usable) {
+                grants.push_back({user, params.bandwidth});
+            }
+        }
+    }
+};
+
+// CSMA/CA: stations take turns on the channel and back off while it is busy
+class CsmaCaAccess {
 private:
-    bool channelBusy;
-    std::mutex channelMutex;
-    double currentTime;
-    const double SIMULATION_TIME = 1000.0; // 1 second in ms
+    double channelBusyUntil = 0.0;
+
+    template <typename AP>
+    double nextEventTime(AP& ap, double now) const;
 
 public:
-    WiFi4AccessPoint(int apId);
+    using UserType = WiFi4User;
+
+    void reset() { channelBusyUntil = 0.0; }
+    bool isChannelFree(double now) const { return now >= channelBusyUntil; }
+    // The channel is held in simulated time only and frees itself afterwards
+    void occupyChannel(double now, double duration) { channelBusyUntil = now + duration; }
 
-    void simulateTransmission() override;
-    double computeThroughput() override;
-    std::pair<double, double> computeLatency() override;
-    bool isChannelFree();
-    void occupyChannel(double duration);
+    template <typename AP>
+    double runRound(AP& ap, double now);
 };
 
+// Latency is each station's accumulated airtime plus backoff
+class StationLatencyStats {
+public:
+    template <typename AP>
+    double throughput(const AP& ap) const {
+        return deliveredThroughput(ap, ap.params.duration);
+    }
+
+    template <typename AP>
+    std::pair<double, double> latency(const AP& ap) const;
+};
+
+class WiFi4AccessPoint : public SimulatedAP<CsmaCaAccess, SequentialScheduler, StationLatencyStats> {
+public:
+    WiFi4AccessPoint(int apId);
+};
+
+// Earliest simulated instant at which the outcome of a round can differ
+template <typename AP>
+double CsmaCaAccess::nextEventTime(AP& ap, double now) const {
+    if (channelBusyUntil > now) return channelBusyUntil;
+
+    // Otherwise the next packet arrival at any queue, or the next link change
+    return ap.nextReadyTime(now);
+}
+
+template <typename AP>
+double CsmaCaAccess::runRound(AP& ap, double now) {
+    bool anyTransmission = false;
+
+    ap.schedule();
+    for (auto& grant : ap.grants) {
+        WiFi4User* user = grant.user;
+        if (isChannelFree(now)) {
+            // Transmit the head of the station's queue
+            auto packet = ap.dequeueUplink(*user, now);
+            if (!packet) continue;
+            double txTime = ap.airtime(*packet, *user, grant.bandwidth);
+            // Nothing may still be on air when the run ends
+            if (now + txTime > ap.params.duration) return ap.params.duration;
+
+            packet->setTransmissionTime(now, now + txTime);
+            user->addTransmittedPacket(*packet);
+            user->addTransmissionTime(txTime);
+            user->addLatency(txTime + user->getBackoffTime());
+            user->resetBackoff();
+
+            ap.transmittedPackets.push_back(std::move(packet));
+            occupyChannel(now, txTime);
+
+            now += txTime;
+            anyTransmission = true;
+        } else {
+            // Channel busy - backoff
+            user->incrementBackoff();
+            now += user->getBackoffTime();
+        }
+    }
+
+    // The AP contends for the channel like one more station
+    if (ap.hasDownlinkTraffic() && isChannelFree(now)) {
+        size_t station = 0;
+        if (auto packet = ap.nextDownlinkPacket(now, station)) {
+            double txTime = ap.airtime(*packet, *ap.users[station], ap.params.bandwidth);
+            if (now + txTime > ap.params.duration) return ap.params.duration;
+            packet->setTransmissionTime(now, now + txTime);
+            ap.transmittedPackets.push_back(std::move(packet));
+            occupyChannel(now, txTime);
+            now += txTime;
+            anyTransmission = true;
+        }
+    }
+
+    if (!anyTransmission) {
+        // Jump to the next event instead of stepping through idle time
+        now = std::max(now, nextEventTime(ap, now));
+    }
+    return now;
+}
+
+template <typename AP>
+std::pair<double, double> StationLatencyStats::latency(const AP& ap) const {
+    if (ap.stations.empty()) return {0.0, 0.0};
+
+    double totalLatency = 0.0;
+    double maxLatency = 0.0;
+
+    for (auto station : ap.stations) {
+        double userLatency = station->getTotalLatency();
+        totalLatency += userLatency;
+        maxLatency = std::max(maxLatency, userLatency);
+    }
+
+    return {totalLatency / ap.stations.size(), maxLatency};
+}
+
 #endif
\ No newline at end of file
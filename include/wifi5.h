@@ -12,7 +12,7 @@ private:
     bool hasChannelState;
 
 public:
-    WiFi5User(int userId);
+    WiFi5User(int userId, int size = 1024);
     std::unique_ptr<Packet> createPacket() override;
     bool canTransmit() override;
     void setChannelState(bool state);
@@ -20,15 +20,100 @@ public:
     std::unique_ptr<Packet> createChannelStatePacket(int size);
 };
 
-class WiFi5AccessPoint : public AccessPoint {
-private:
-    const double PARALLEL_TIME;
+// MU-MIMO: the AP sounds the channel, collects CSI from every station in
+// turn, then serves the scheduled stations in parallel for a fixed window
+class MuMimoSoundingAccess {
+public:
+    using UserType = WiFi5User;
+
+    void reset() {}
+
+    template <typename AP>
+    double runRound(AP& ap, double now);
+};
 
+// Latency is averaged over every packet sent, including sounding traffic
+class PacketLatencyStats {
+public:
+    template <typename AP>
+    double throughput(const AP& ap) const {
+        return deliveredThroughput(ap, ap.params.duration);
+    }
+
+    template <typename AP>
+    std::pair<double, double> latency(const AP& ap) const;
+};
+
+class WiFi5AccessPoint : public SimulatedAP<MuMimoSoundingAccess, SequentialScheduler, PacketLatencyStats> {
 public:
     WiFi5AccessPoint(int apId);
-    void simulateTransmission() override;
-    double computeThroughput() override;
-    std::pair<double, double> computeLatency() override;
 };
 
+template <typename AP>
+double MuMimoSoundingAccess::runRound(AP& ap, double now) {
+    // Sound only when some queue has data; otherwise jump to the next arrival
+    double ready = ap.nextReadyTime(now);
+    if (ready > now) return ready;
+
+    // Step 1: AP broadcasts packet
+    const ProtocolParams& params = ap.params;
+
+    // Only start a cycle that can finish before the run ends
+    double cycleTime = Packet(params.packetSize).calculateTransmissionTime(params.bandwidth, params.modulationBits, params.codingRate)
+                       + params.parallelTime;
+    Packet csiProbe(params.csiSize);
+    for (auto user : ap.stations) {
+        if (user->getLink().usable) {
+            cycleTime += csiProbe.calculateTransmissionTime(params.bandwidth, params.modulationBits, params.codingRate);
+        }
+    }
+    if (now + cycleTime > params.duration) return params.duration;
+
+    auto broadcastPacket = std::make_unique<Packet>(params.packetSize, 0, -1); // Broadcast
+    double broadcastTime = broadcastPacket->calculateTransmissionTime(params.bandwidth, params.modulationBits, params.codingRate);
+    broadcastPacket->setTransmissionTime(now, now + broadcastTime);
+    ap.transmittedPackets.push_back(std::move(broadcastPacket));
+    now += broadcastTime;
+
+    // Step 2: Sequential channel state information from every reachable
+    // station; only those the AP can steer a beam to join the window
+    for (auto user : ap.stations) {
+        if (!user->getLink().usable) continue;
+        auto csiPacket = user->createChannelStatePacket(params.csiSize);
+        double csiTime = csiPacket->calculateTransmissionTime(params.bandwidth, params.modulationBits, params.codingRate);
+        csiPacket->setTransmissionTime(now, now + csiTime);
+        ap.transmittedPackets.push_back(std::move(csiPacket));
+        user->setChannelState(user->isInBeamformedRange());
+        now += csiTime;
+    }
+
+    // Step 3: Parallel transmission for the MU-MIMO window
+    ap.schedule();
+    ap.transmitWindow(now, params.parallelTime);
+    now += params.parallelTime;
+
+    // Reset channel state for next cycle
+    for (auto user : ap.stations) {
+        user->setChannelState(false);
+    }
+    return now;
+}
+
+template <typename AP>
+std::pair<double, double> PacketLatencyStats::latency(const AP& ap) const {
+    const auto& packets = ap.getTransmittedPackets();
+    if (packets.empty()) return {0.0, 0.0};
+
+    double totalLatency = 0.0;
+    double maxLatency = 0.0;
+
+    for (const auto& packet : packets) {
+        double latency = packet->getLatency();
+        totalLatency += latency;
+        maxLatency = std::max(maxLatency, latency);
+    }
+
+    return {totalLatency / packets.size(), maxLatency};
+}
+
 #endif // WIFI_5_H
@@ -1,6 +1,8 @@
 #ifndef WIFI_6_H
 #define WIFI_6_H
 
+#include <algorithm>
+#include <cmath>
 #include "./ap.h"
 // #include "./channel.h"
 #include "./packet.h"
@@ -8,28 +10,85 @@
 #include "./wifi5.h"
 
 
-class WiFi6User : public WiFi5User {
+// Plain OFDMA never sounds, so a WiFi 6 station starts out able to send.
+// Behind a sounding AP it is gated on the sounding result like any
+// WiFi 5 station.
+class WiFi6User final : public WiFi5User {
 public:
-    WiFi6User(int userId);
+    WiFi6User(int userId, int size = 1024);
 
     std::unique_ptr<Packet> createPacket() override;
-    bool canTransmit() override;
 };
 
-
-class WiFi6AccessPoint : public AccessPoint {
+// Hands out resource units of rotating sizes until the channel is full;
+// stations left over are first in line for the next window
+class RoundRobinRuScheduler {
 private:
-    const double CHANNEL_ALLOCATION_TIME;
-    std::vector<int> subChannelSizes;
+    size_t userIndex = 0;
+    size_t stationCursor = 0;
 
 public:
-    WiFi6AccessPoint(int apId);
+    // A resource unit is the station's for the whole window
+    static constexpr bool FILLS_WINDOW = true;
+
+    void reset() {
+        userIndex = 0;
+        stationCursor = 0;
+    }
 
-    void simulateTransmission() override;
-    double computeThroughput() override;
-    std::pair<double, double> computeLatency() override;
+    template <typename UserT>
+    void schedule(const std::vector<UserT*>& stations, const ProtocolParams& params, std::vector<Grant<UserT>>& grants) {
+        const std::vector<int>& sizes = params.subChannelSizes;
+        size_t count = stations.size();
+        double allocated = 0.0;
+        size_t next = stationCursor;
+        for (size_t k = 0; k < count; ++k) {
+            size_t index = (stationCursor + k) % count;
+            UserT* user = stations[index];
+            if (!user->canTransmit() || !user->getLink().usable) continue;
+            double ru = sizes[userIndex % sizes.size()];
+            if (allocated + ru > params.bandwidth) break;
+            grants.push_back({user, ru});
+            allocated += ru;
+            userIndex++;
+            next = index + 1;
+        }
+        stationCursor = count > 0 ? next % count : 0;
+    }
 };
 
+// OFDMA: every scheduled station transmits on its own RU within a fixed window
+class OfdmaAccess {
+public:
+    using UserType = WiFi6User;
+
+    void reset() {}
+
+    template <typename AP>
+    double runRound(AP& ap, double now) {
+        double ready = ap.nextReadyTime(now);
+        if (ready > now) {
+            // Nothing queued: resume at the first window boundary after the next arrival
+            double window = ap.params.allocationTime;
+            return std::max(ready, std::ceil(ready / window) * window);
+        }
+        ap.schedule();
+        if (ap.grants.empty()) {
+            // No station can be scheduled until a link changes: skip the empty windows
+            return ap.idleUntil(now);
+        }
+        if (now + ap.params.allocationTime > ap.params.duration) return ap.params.duration;
+        ap.transmitWindow(now, ap.params.allocationTime);
+        return now + ap.params.allocationTime;
+    }
+};
+
+class WiFi6AccessPoint : public SimulatedAP<OfdmaAccess, RoundRobinRuScheduler, PacketLatencyStats> {
+public:
+    WiFi6AccessPoint(int apId);
+};
 
+// Hybrid: MU-MIMO sounding with the parallel window split into OFDMA RUs
+using WiFi6MuMimoAccessPoint = SimulatedAP<MuMimoSoundingAccess, RoundRobinRuScheduler, PacketLatencyStats>;
 
-#endif // WIFI_SIMULATION_H
\ No newline at end of file
+#endif // WIFI_6_H
@@ -9,12 +9,83 @@
 #include <iomanip>
 #include <vector>
 
-AccessPoint::AccessPoint(int apId, double bw) : id(apId), bandwidth(bw) {}
+AccessPoint::AccessPoint(int apId, double bw)
+    : id(apId), bandwidth(bw), downlinkCursor(0), downlinkActive(false) {
+    params.bandwidth = bw;
+}
+
+void AccessPoint::setProtocolParams(const ProtocolParams& p) {
+    params = p;
+    bandwidth = p.bandwidth;
+}
+
+void AccessPoint::setQueueConfig(const QueueConfig& config) {
+    queueConfig = config;
+}
 
 void AccessPoint::addUser(std::unique_ptr<User> user) {
+    addUser(std::move(user), queueConfig.uplinkRate, queueConfig.downlinkRate);
+}
+
+void AccessPoint::addUser(std::unique_ptr<User> user, double uplinkRate, double downlinkRate) {
+    user->getUplinkQueue() = PacketQueue(queueConfig, uplinkRate);
+    downlinkQueues.emplace_back(queueConfig, downlinkRate);
+    if (downlinkRate != 0.0) downlinkActive = true;
     users.push_back(std::move(user));
 }
 
+std::unique_ptr<Packet> AccessPoint::dequeueDownlink(size_t station, double now) {
+    PacketQueue& queue = downlinkQueues[station];
+    if (queue.arrivalsDue(now)) {
+        // Downlink traffic mirrors the station's own packet size
+        queue.offer(now, users[station]->getPacketSize(), 0, users[station]->getId());
+    }
+
+    QueuedPacket head;
+    if (!queue.dequeue(now, head)) return nullptr;
+    downlinkDelay.record(now - head.enqueueTime);
+    return std::make_unique<Packet>(head.size, head.sourceId, head.destinationId);
+}
+
+std::unique_ptr<Packet> AccessPoint::nextDownlinkPacket(double now, size_t& station) {
+    for (size_t tried = 0; tried < downlinkQueues.size(); ++tried) {
+        station = downlinkCursor;
+        downlinkCursor = (downlinkCursor + 1) % downlinkQueues.size();
+        if (!users[station]->getLink().usable) continue;
+        if (auto packet = dequeueDownlink(station, now)) return packet;
+    }
+    return nullptr;
+}
+
+void AccessPoint::setMobility(std::unique_ptr<MobilityModel> model) {
+    mobility = std::move(model);
+    if (!mobility) return;
+    mobility->evaluateAllLinks();
+    for (size_t station : mobility->changedStations()) {
+        if (station < users.size()) users[station]->setLink(mobility->link(station));
+    }
+}
+
+void AccessPoint::advanceMobility(double now) {
+    if (!mobility || now < mobility->nextUpdateTime()) return;
+    mobility->advanceTo(now);
+    for (size_t station : mobility->changedStations()) {
+        if (station < users.size()) users[station]->setLink(mobility->link(station));
+    }
+}
+
+double AccessPoint::airtime(const Packet& packet, const User& user, double bandwidthMhz) const {
+    const Link& link = user.getLink();
+    if (link.modulationBits > 0) {
+        return packet.calculateTransmissionTime(bandwidthMhz, link.modulationBits, link.codingRate);
+    }
+    return packet.calculateTransmissionTime(bandwidthMhz, params.modulationBits, params.codingRate);
+}
+
+bool AccessPoint::hasDownlinkTraffic() const {
+    return downlinkActive;
+}
+
 const std::vector<std::unique_ptr<Packet>>& AccessPoint::getTransmittedPackets() const {
     return transmittedPackets;
 }
@@ -26,3 +97,7 @@ int AccessPoint::getBandwidth() const { return bandwidth; }
 const std::vector<std::unique_ptr<User>>& AccessPoint::getUsers() const {
     return users;
 }
+
+const LatencyHistogram& AccessPoint::getUplinkQueueingDelay() const { return uplinkDelay; }
+
+const LatencyHistogram& AccessPoint::getDownlinkQueueingDelay() const { return downlinkDelay; }
@@ -0,0 +1,74 @@
+#include "../include/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const uint64_t SUB_BUCKETS = 1ULL << 7;
+const uint64_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+// Direct buckets for [0, 128) plus 64 per remaining power of two
+const size_t BUCKET_COUNT = SUB_BUCKETS + (64 - 7) * HALF_SUB_BUCKETS;
+
+int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts(BUCKET_COUNT, 0), totalCount(0), maxValue(0), sum(0.0) {}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+    int shift = highestBit(value) - (SUB_BUCKET_BITS - 1);
+    uint64_t top = value >> shift; // in [64, 128)
+    return SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS + (top - HALF_SUB_BUCKETS);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    size_t offset = index - SUB_BUCKETS;
+    int shift = static_cast<int>(offset / HALF_SUB_BUCKETS) + 1;
+    uint64_t top = HALF_SUB_BUCKETS + offset % HALF_SUB_BUCKETS;
+    return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(double latencyMs) {
+    uint64_t micros = latencyMs > 0.0 ? static_cast<uint64_t>(std::llround(latencyMs * 1000.0)) : 0;
+    ++counts[bucketIndex(micros)];
+    ++totalCount;
+    maxValue = std::max(maxValue, micros);
+    sum += latencyMs;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    totalCount += other.totalCount;
+    maxValue = std::max(maxValue, other.maxValue);
+    sum += other.sum;
+}
+
+double LatencyHistogram::percentile(double p) const {
+    if (totalCount == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * totalCount));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), maxValue) / 1000.0;
+        }
+    }
+    return maxValue / 1000.0;
+}
+
+double LatencyHistogram::mean() const {
+    return totalCount > 0 ? sum / totalCount : 0.0;
+}
+
+double LatencyHistogram::max() const { return maxValue / 1000.0; }
+
+uint64_t LatencyHistogram::count() const { return totalCount; }
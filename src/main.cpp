@@ -1,86 +1,71 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <iomanip>
 #include <memory>
+#include <sstream>
+#include <string>
 
-#include "../include/ap.h"
-#include "../include/wifi4.h"
-#include "../include/wifi5.h"
-#include "../include/wifi6.h"
+#include "../include/metrics.h"
+#include "../include/result.h"
+#include "../include/result_cache.h"
+#include "../include/scenario.h"
+#include "../include/simulation.h"
+#include "../include/station_table.h"
 
-struct Result {
-    int users;
-    double wifi4Throughput, wifi5Throughput, wifi6Throughput;        // Mbps
-    double wifi4AvgLatency, wifi5AvgLatency, wifi6AvgLatency;        // ms
-    double wifi4MaxLatency, wifi5MaxLatency, wifi6MaxLatency;        // ms
-};
+void runSimulation(std::vector<Result>& results, ResultCache* cache, const ScenarioConfig& config,
+                   const StationTable& stations) {
+    simulationMetrics().scenariosPlanned.store(config.userCounts.size() * config.accessPoints.size(),
+                                               std::memory_order_relaxed);
 
-void runSimulation(std::vector<Result>& results) {
-    std::vector<int> userScenarios = {1, 10, 100};
-
-    for (int numUsers : userScenarios) {
+    for (int numUsers : config.userCounts) {
         std::cout << "\n===== Simulation with " << numUsers << " Users =====\n";
-        Result result = {numUsers, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-        // WiFi 4 Simulation
-        {
-            std::cout << "Running WiFi 4 (CSMA/CA) simulation...\n";
-            auto ap = std::make_unique<WiFi4AccessPoint>(1);
-            for (int i = 0; i < numUsers; ++i) {
-                ap->addUser(std::make_unique<WiFi4User>(i));
-            }
-            ap->simulateTransmission();
-            result.wifi4Throughput = ap->computeThroughput();
-            auto [avgLat, maxLat] = ap->computeLatency();
-            result.wifi4AvgLatency = avgLat;
-            result.wifi4MaxLatency = maxLat;
-            std::cout << "  Throughput: " << std::fixed << std::setprecision(2) 
-                      << result.wifi4Throughput << " Mbps\n";
-            std::cout << "  Avg Latency: " << result.wifi4AvgLatency << " ms\n";
-            std::cout << "  Max Latency: " << result.wifi4MaxLatency << " ms\n";
-        }
-
-        // WiFi 5 Simulation
-        {
-            std::cout << "Running WiFi 5 (MU-MIMO) simulation...\n";
-            auto ap = std::make_unique<WiFi5AccessPoint>(1);
-            for (int i = 0; i < numUsers; ++i) {
-                ap->addUser(std::make_unique<WiFi5User>(i));
-            }
-            ap->simulateTransmission();
-            result.wifi5Throughput = ap->computeThroughput();
-            auto [avgLat, maxLat] = ap->computeLatency();
-            result.wifi5AvgLatency = avgLat;
-            result.wifi5MaxLatency = maxLat;
-            std::cout << "  Throughput: " << std::fixed << std::setprecision(2) 
-                      << result.wifi5Throughput << " Mbps\n";
-            std::cout << "  Avg Latency: " << result.wifi5AvgLatency << " ms\n";
-            std::cout << "  Max Latency: " << result.wifi5MaxLatency << " ms\n";
-        }
+        Result result{};
+        result.users = numUsers;
 
-        // WiFi 6 Simulation
-        {
-            std::cout << "Running WiFi 6 (OFDMA) simulation...\n";
-            auto ap = std::make_unique<WiFi6AccessPoint>(1);
-            for (int i = 0; i < numUsers; ++i) {
-                ap->addUser(std::make_unique<WiFi6User>(i));
+        for (const auto& name : config.accessPoints) {
+            const char* label = name == "wifi4" ? "WiFi 4 (CSMA/CA)" : name == "wifi5" ? "WiFi 5 (MU-MIMO)" : "WiFi 6 (OFDMA)";
+            // Each protocol is keyed on its own settings, so changing a knob
+            // only one protocol reads leaves the others' entries valid
+            uint64_t key = ResultCache::makeKey("users=" + std::to_string(numUsers) + ";" + describeScenario(config, name));
+            ProtocolResult r{};
+            if (cache && cache->lookup(key, r)) {
+                std::cout << "Using cached " << label << " results (key " << std::hex << key << std::dec << ")\n";
+                simulationMetrics().scenariosCompleted.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                std::cout << "Running " << label << " simulation...\n";
+                r = runProtocol(name, config, stations, numUsers);
+                if (cache) cache->store(key, r);
             }
-            ap->simulateTransmission();
-            result.wifi6Throughput = ap->computeThroughput();
-            auto [avgLat, maxLat] = ap->computeLatency();
-            result.wifi6AvgLatency = avgLat;
-            result.wifi6MaxLatency = maxLat;
-            std::cout << "  Throughput: " << std::fixed << std::setprecision(2) 
-                      << result.wifi6Throughput << " Mbps\n";
-            std::cout << "  Avg Latency: " << result.wifi6AvgLatency << " ms\n";
-            std::cout << "  Max Latency: " << result.wifi6MaxLatency << " ms\n";
+            std::cout << "  Throughput: " << std::fixed << std::setprecision(2)
+                      << r.throughput << " Mbps\n";
+            std::cout << "  Avg Latency: " << r.avgLatency << " ms\n";
+            std::cout << "  Max Latency: " << r.maxLatency << " ms\n";
+            std::cout << "  Queueing Delay P50/P99: " << r.queueP50 << " / " << r.queueP99 << " ms\n";
+            storeProtocolResult(result, name, r);
         }
 
         results.push_back(result);
     }
 }
 
-void printResults(const std::vector<Result>& results) {
+bool wasRun(const ScenarioConfig& config, const std::string& name) {
+    return std::find(config.accessPoints.begin(), config.accessPoints.end(), name) != config.accessPoints.end();
+}
+
+// Table cell for one protocol's metric; "-" when the protocol was not run
+std::string cell(bool run, double value, int precision) {
+    if (!run) return "-";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << value;
+    return out.str();
+}
+
+void printResults(const std::vector<Result>& results, const ScenarioConfig& config) {
+    bool wifi4 = wasRun(config, "wifi4");
+    bool wifi5 = wasRun(config, "wifi5");
+    bool wifi6 = wasRun(config, "wifi6");
+
     std::cout << "\n" << std::string(120, '=') << "\n";
     std::cout << "               WiFi Communication Simulation Results Summary\n";
     std::cout << std::string(120, '=') << "\n";
@@ -118,79 +103,197 @@ void printResults(const std::vector<Result>& results) {
     for (const auto& result : results) {
         std::cout << std::left 
                   << std::setw(8) << result.users
-                  << std::setw(15) << std::fixed << std::setprecision(2) << result.wifi4Throughput
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi4AvgLatency
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi4MaxLatency
-                  << std::setw(15) << std::fixed << std::setprecision(2) << result.wifi5Throughput
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi5AvgLatency
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi5MaxLatency
-                  << std::setw(15) << std::fixed << std::setprecision(2) << result.wifi6Throughput
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi6AvgLatency
-                  << std::setw(15) << std::fixed << std::setprecision(3) << result.wifi6MaxLatency
+                  << std::setw(15) << cell(wifi4, result.wifi4Throughput, 2)
+                  << std::setw(15) << cell(wifi4, result.wifi4AvgLatency, 3)
+                  << std::setw(15) << cell(wifi4, result.wifi4MaxLatency, 3)
+                  << std::setw(15) << cell(wifi5, result.wifi5Throughput, 2)
+                  << std::setw(15) << cell(wifi5, result.wifi5AvgLatency, 3)
+                  << std::setw(15) << cell(wifi5, result.wifi5MaxLatency, 3)
+                  << std::setw(15) << cell(wifi6, result.wifi6Throughput, 2)
+                  << std::setw(15) << cell(wifi6, result.wifi6AvgLatency, 3)
+                  << std::setw(15) << cell(wifi6, result.wifi6MaxLatency, 3)
                   << "\n";
     }
     
     std::cout << std::string(120, '-') << "\n";
+
+    // Queueing delay percentiles
+    std::cout << "\nQueueing Delay (ms, uplink + downlink)\n";
+    std::cout << std::left
+              << std::setw(8) << "Users"
+              << std::setw(15) << "WiFi4 P50"
+              << std::setw(15) << "WiFi4 P99"
+              << std::setw(15) << "WiFi5 P50"
+              << std::setw(15) << "WiFi5 P99"
+              << std::setw(15) << "WiFi6 P50"
+              << std::setw(15) << "WiFi6 P99"
+              << "\n";
+    std::cout << std::string(98, '-') << "\n";
+
+    for (const auto& result : results) {
+        std::cout << std::left
+                  << std::setw(8) << result.users
+                  << std::setw(15) << cell(wifi4, result.wifi4QueueP50, 3)
+                  << std::setw(15) << cell(wifi4, result.wifi4QueueP99, 3)
+                  << std::setw(15) << cell(wifi5, result.wifi5QueueP50, 3)
+                  << std::setw(15) << cell(wifi5, result.wifi5QueueP99, 3)
+                  << std::setw(15) << cell(wifi6, result.wifi6QueueP50, 3)
+                  << std::setw(15) << cell(wifi6, result.wifi6QueueP99, 3)
+                  << "\n";
+    }
+
+    std::cout << std::string(98, '-') << "\n";
     
     // Add simulation parameters
     std::cout << "\nSimulation Parameters:\n";
-    std::cout << "• Bandwidth: 20 MHz\n";
-    std::cout << "• Modulation: 256-QAM (8 bits/symbol)\n";
-    std::cout << "• Coding Rate: 5/6\n";
-    std::cout << "• Packet Size: 1024 bytes (1 KB)\n";
-    std::cout << "• WiFi 5 CSI Packet Size: 200 bytes\n";
-    std::cout << "• WiFi 5 Parallel Window: 15 ms\n";
-    std::cout << "• WiFi 6 Sub-channels: 2, 4, 10 MHz\n";
-    std::cout << "• WiFi 6 Allocation Window: 5 ms\n";
-    std::cout << "• Simulation Duration: 1000 ms (1 second)\n";
+    const ProtocolParams& params = config.params;
+    const QueueConfig& queueConfig = config.queue;
+    std::cout << std::defaultfloat;
+    std::cout << "• Bandwidth: " << params.bandwidth << " MHz\n";
+    std::cout << "• Modulation: " << (1 << params.modulationBits) << "-QAM ("
+              << params.modulationBits << " bits/symbol)\n";
+    std::cout << "• Coding Rate: " << std::setprecision(3) << params.codingRate << std::setprecision(6) << "\n";
+    std::cout << "• Packet Size: " << params.packetSize << " bytes\n";
+    std::cout << "• WiFi 5 CSI Packet Size: " << params.csiSize << " bytes\n";
+    std::cout << "• WiFi 5 Parallel Window: " << params.parallelTime << " ms\n";
+    std::cout << "• WiFi 6 Sub-channels: ";
+    for (size_t i = 0; i < params.subChannelSizes.size(); ++i) {
+        std::cout << (i ? ", " : "") << params.subChannelSizes[i];
+    }
+    std::cout << " MHz\n";
+    std::cout << "• WiFi 6 Allocation Window: " << params.allocationTime << " ms\n";
+    std::cout << "• Simulation Duration: " << params.duration << " ms\n";
+    std::cout << "• Queue Capacity: " << queueConfig.capacity << " packets per station and direction\n";
+    std::cout << "• AQM: " << (queueConfig.aqm == AqmMode::CoDel ? "CoDel" : "Drop-tail") << "\n";
+    if (config.mobility.enabled) {
+        const MobilityConfig& m = config.mobility;
+        const char* patterns[] = {"static", "linear", "random waypoint"};
+        std::cout << "• Mobility: " << patterns[static_cast<int>(m.pattern)] << " at " << m.speed
+                  << " m/s in " << m.areaWidth << " x " << m.areaHeight << " m\n";
+    }
+    std::cout << "• Uplink Load: ";
+    if (queueConfig.uplinkRate == SATURATED) std::cout << "saturated\n";
+    else std::cout << queueConfig.uplinkRate << " packets/ms per station\n";
+    std::cout << "• Downlink Load: ";
+    if (queueConfig.downlinkRate == SATURATED) std::cout << "saturated\n";
+    else std::cout << queueConfig.downlinkRate << " packets/ms per station\n";
 }
 
-void printDetailedAnalysis(const std::vector<Result>& results) {
+void printDetailedAnalysis(const std::vector<Result>& results, const ScenarioConfig& config) {
+    bool wifi4 = wasRun(config, "wifi4");
+    bool wifi5 = wasRun(config, "wifi5");
+    bool wifi6 = wasRun(config, "wifi6");
+
     std::cout << "\n" << std::string(80, '=') << "\n";
     std::cout << "                    Performance Analysis\n";
     std::cout << std::string(80, '=') << "\n";
     
     for (const auto& result : results) {
         std::cout << "\n--- " << result.users << " User" << (result.users > 1 ? "s" : "") << " ---\n";
+
+        // Improvement over WiFi 4, when there is a WiFi 4 baseline to compare with
+        auto improvement = [&](double throughput) {
+            if (wifi4 && result.wifi4Throughput > 0.0 && throughput > result.wifi4Throughput) {
+                std::cout << " (+" << std::setprecision(1) 
+                          << ((throughput - result.wifi4Throughput) / result.wifi4Throughput * 100) 
+                          << "% improvement)" << std::setprecision(2);
+            }
+            std::cout << "\n";
+        };
         
         // Throughput comparison
-        std::cout << "Throughput Comparison:\n";
-        std::cout << "  WiFi 4 (CSMA/CA): " << std::fixed << std::setprecision(2) 
-                  << result.wifi4Throughput << " Mbps\n";
-        std::cout << "  WiFi 5 (MU-MIMO): " << result.wifi5Throughput << " Mbps";
-        if (result.wifi5Throughput > result.wifi4Throughput) {
-            std::cout << " (+" << std::setprecision(1) 
-                      << ((result.wifi5Throughput - result.wifi4Throughput) / result.wifi4Throughput * 100) 
-                      << "% improvement)";
+        std::cout << "Throughput Comparison:\n" << std::fixed << std::setprecision(2);
+        if (wifi4) std::cout << "  WiFi 4 (CSMA/CA): " << result.wifi4Throughput << " Mbps\n";
+        if (wifi5) {
+            std::cout << "  WiFi 5 (MU-MIMO): " << result.wifi5Throughput << " Mbps";
+            improvement(result.wifi5Throughput);
         }
-        std::cout << "\n";
-        
-        std::cout << "  WiFi 6 (OFDMA):   " << result.wifi6Throughput << " Mbps";
-        if (result.wifi6Throughput > result.wifi4Throughput) {
-            std::cout << " (+" << std::setprecision(1) 
-                      << ((result.wifi6Throughput - result.wifi4Throughput) / result.wifi4Throughput * 100) 
-                      << "% improvement)";
+        if (wifi6) {
+            std::cout << "  WiFi 6 (OFDMA):   " << result.wifi6Throughput << " Mbps";
+            improvement(result.wifi6Throughput);
         }
-        std::cout << "\n";
         
         // Latency comparison
-        std::cout << "\nAverage Latency Comparison:\n";
-        std::cout << "  WiFi 4: " << std::fixed << std::setprecision(3) 
-                  << result.wifi4AvgLatency << " ms\n";
-        std::cout << "  WiFi 5: " << result.wifi5AvgLatency << " ms\n";
-        std::cout << "  WiFi 6: " << result.wifi6AvgLatency << " ms\n";
+        std::cout << "\nAverage Latency Comparison:\n" << std::fixed << std::setprecision(3);
+        if (wifi4) std::cout << "  WiFi 4: " << result.wifi4AvgLatency << " ms\n";
+        if (wifi5) std::cout << "  WiFi 5: " << result.wifi5AvgLatency << " ms\n";
+        if (wifi6) std::cout << "  WiFi 6: " << result.wifi6AvgLatency << " ms\n";
         
-        // Best performer
-        double bestThroughput = std::max({result.wifi4Throughput, result.wifi5Throughput, result.wifi6Throughput});
-        std::string bestProtocol = (bestThroughput == result.wifi4Throughput) ? "WiFi 4" :
-                                  (bestThroughput == result.wifi5Throughput) ? "WiFi 5" : "WiFi 6";
+        // Best performer among the protocols that ran
+        std::string bestProtocol;
+        double bestThroughput = 0.0;
+        if (wifi4) {
+            bestProtocol = "WiFi 4";
+            bestThroughput = result.wifi4Throughput;
+        }
+        if (wifi5 && (bestProtocol.empty() || result.wifi5Throughput > bestThroughput)) {
+            bestProtocol = "WiFi 5";
+            bestThroughput = result.wifi5Throughput;
+        }
+        if (wifi6 && (bestProtocol.empty() || result.wifi6Throughput > bestThroughput)) {
+            bestProtocol = "WiFi 6";
+            bestThroughput = result.wifi6Throughput;
+        }
         std::cout << "\nBest Throughput: " << bestProtocol << " with " 
                   << std::fixed << std::setprecision(2) << bestThroughput << " Mbps\n";
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     std::vector<Result> results;
+    bool useCache = true;
+    ScenarioConfig config;
+    std::string scenarioPath;
+    bool codel = false;
+    bool downlinkGiven = false;
+    double downlinkRate = 0.0;
+    std::string metricsPath;
+    double metricsInterval = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--no-cache") useCache = false;
+        else if (arg == "--codel") codel = true;
+        else if (arg == "--downlink-rate" && i + 1 < argc) {
+            if (!parseRate(trim(argv[++i]), downlinkRate)) {
+                std::cerr << "Error: --downlink-rate expects packets/ms >= 0 or 'saturated', got '" << argv[i]
+                          << "'\n";
+                return 1;
+            }
+            downlinkGiven = true;
+        }
+        else if (arg == "--scenario" && i + 1 < argc) scenarioPath = argv[++i];
+        else if (arg == "--metrics-file" && i + 1 < argc) metricsPath = argv[++i];
+        else if (arg == "--metrics-interval" && i + 1 < argc) {
+            if (!parseDouble(trim(argv[++i]), metricsInterval) || metricsInterval <= 0.0) {
+                std::cerr << "Error: --metrics-interval expects seconds > 0, got '" << argv[i] << "'\n";
+                return 1;
+            }
+        }
+        else if (arg == "--convert-stations" && i + 2 < argc) {
+            std::string error;
+            if (!convertStationTable(argv[i + 1], argv[i + 2], error)) {
+                std::cerr << "Error: " << error << "\n";
+                return 1;
+            }
+            std::cout << "Wrote station table " << argv[i + 2] << "\n";
+            return 0;
+        }
+    }
+
+    std::string error;
+    if (!scenarioPath.empty() && !loadScenario(scenarioPath, config, error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    // Command-line switches override the scenario file
+    if (codel) config.queue.aqm = AqmMode::CoDel;
+    if (downlinkGiven) config.queue.downlinkRate = downlinkRate;
+
+    StationTable stations;
+    if (!config.stationTable.empty() && !stations.open(config.stationTable, error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
     
     std::cout << std::string(60, '=') << "\n";
     std::cout << "        WiFi Communication Simulator\n";
@@ -199,9 +302,15 @@ int main() {
     
     std::cout << "\nStarting simulations...\n";
     
-    runSimulation(results);
-    printResults(results);
-    printDetailedAnalysis(results);
+    std::unique_ptr<ResultCache> cache;
+    if (useCache) cache = std::make_unique<ResultCache>(".wifi_sim_cache");
+    // Progress for long sweeps: rewritten in the background, e.g. `watch cat FILE`
+    std::unique_ptr<MetricsExporter> exporter;
+    if (!metricsPath.empty()) exporter = std::make_unique<MetricsExporter>(metricsPath, metricsInterval);
+    runSimulation(results, cache.get(), config, stations);
+    exporter.reset();
+    printResults(results, config);
+    printDetailedAnalysis(results, config);
     
     std::cout << "\nSimulation completed successfully!\n";
     std::cout << std::string(60, '=') << "\n";
@@ -0,0 +1,129 @@
+#include "../include/metrics.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void writeMetric(std::ostream& out, const char* name, const char* type, const char* help, double value) {
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " " << type << "\n"
+        << name << " " << value << "\n";
+}
+
+} // namespace
+
+SimulationMetrics& simulationMetrics() {
+    static SimulationMetrics metrics;
+    return metrics;
+}
+
+RunProgress::RunProgress() {
+    simulationMetrics().activeRuns.fetch_add(1, std::memory_order_relaxed);
+}
+
+RunProgress::~RunProgress() {
+    simulationMetrics().activeRuns.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RunProgress::publish(size_t totalEvents, double now) {
+    SimulationMetrics& metrics = simulationMetrics();
+    rounds = 0;
+    if (totalEvents > publishedEvents) {
+        metrics.events.fetch_add(totalEvents - publishedEvents, std::memory_order_relaxed);
+        publishedEvents = totalEvents;
+    }
+    uint64_t micros = static_cast<uint64_t>(std::llround(now * 1000.0));
+    if (micros > publishedMicros) {
+        metrics.simulatedMicros.fetch_add(micros - publishedMicros, std::memory_order_relaxed);
+        publishedMicros = micros;
+    }
+    metrics.lastProgressNanos.store(steadyNanos(), std::memory_order_relaxed);
+}
+
+uint64_t residentMemoryBytes() {
+    std::ifstream statm("/proc/self/statm");
+    uint64_t totalPages = 0, residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) return 0;
+    return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+MetricsExporter::MetricsExporter(const std::string& file, double interval)
+    : path(file), intervalSeconds(interval > 0.0 ? interval : 1.0) {
+    startNanos = lastSnapshotNanos = steadyNanos();
+    SimulationMetrics& metrics = simulationMetrics();
+    lastEvents = metrics.events.load(std::memory_order_relaxed);
+    lastSimulatedMicros = metrics.simulatedMicros.load(std::memory_order_relaxed);
+    writeSnapshot();
+    worker = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    writeSnapshot();
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto interval = std::chrono::duration<double>(intervalSeconds);
+    while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+        writeSnapshot();
+    }
+}
+
+void MetricsExporter::writeSnapshot() {
+    const SimulationMetrics& metrics = simulationMetrics();
+    uint64_t events = metrics.events.load(std::memory_order_relaxed);
+    uint64_t simulatedMicros = metrics.simulatedMicros.load(std::memory_order_relaxed);
+    int64_t lastProgress = metrics.lastProgressNanos.load(std::memory_order_relaxed);
+    int64_t now = steadyNanos();
+
+    // Rates over the time since the previous snapshot
+    double elapsed = (now - lastSnapshotNanos) / 1e9;
+    double eventRate = elapsed > 0.0 ? (events - lastEvents) / elapsed : 0.0;
+    double simulatedRate = elapsed > 0.0 ? (simulatedMicros - lastSimulatedMicros) / 1000.0 / elapsed : 0.0;
+    lastEvents = events;
+    lastSimulatedMicros = simulatedMicros;
+    lastSnapshotNanos = now;
+
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::trunc);
+        if (!out) return;
+        out.precision(15); // counters print as exact integers
+        writeMetric(out, "wifi_sim_scenarios_planned", "gauge", "Protocol runs in the sweep.",
+                    metrics.scenariosPlanned.load(std::memory_order_relaxed));
+        writeMetric(out, "wifi_sim_scenarios_completed_total", "counter", "Protocol runs finished, including cache hits.",
+                    metrics.scenariosCompleted.load(std::memory_order_relaxed));
+        writeMetric(out, "wifi_sim_active_runs", "gauge", "Simulation runs in progress.",
+                    metrics.activeRuns.load(std::memory_order_relaxed));
+        writeMetric(out, "wifi_sim_events_total", "counter", "Transmissions simulated.", events);
+        writeMetric(out, "wifi_sim_events_per_second", "gauge", "Transmissions simulated per wall-clock second.",
+                    eventRate);
+        writeMetric(out, "wifi_sim_simulated_ms_total", "counter", "Simulated time covered, in ms.",
+                    simulatedMicros / 1000.0);
+        writeMetric(out, "wifi_sim_simulated_ms_per_second", "gauge", "Simulated ms per wall-clock second.",
+                    simulatedRate);
+        writeMetric(out, "wifi_sim_seconds_since_progress", "gauge",
+                    "Wall-clock seconds since a run last published progress; grows while a run stalls.",
+                    lastProgress > 0 ? (now - lastProgress) / 1e9 : 0.0);
+        writeMetric(out, "wifi_sim_resident_memory_bytes", "gauge", "Resident set size.",
+                    static_cast<double>(residentMemoryBytes()));
+        writeMetric(out, "wifi_sim_uptime_seconds", "gauge", "Wall-clock seconds since export started.",
+                    (now - startNanos) / 1e9);
+        if (!out) return;
+    }
+    std::rename(tmpPath.c_str(), path.c_str());
+}
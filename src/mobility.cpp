@@ -0,0 +1,242 @@
+#include "../include/mobility.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+struct McsEntry {
+    double minSnr;       // dB
+    int modulationBits;
+    double codingRate;
+};
+
+// 802.11ac/ax MCS 0-9 with typical single-stream SNR requirements
+const McsEntry MCS_TABLE[] = {
+    {5.0, 1, 1.0 / 2.0},   // BPSK
+    {8.0, 2, 1.0 / 2.0},   // QPSK
+    {11.0, 2, 3.0 / 4.0},
+    {14.0, 4, 1.0 / 2.0},  // 16-QAM
+    {17.0, 4, 3.0 / 4.0},
+    {21.0, 6, 2.0 / 3.0},  // 64-QAM
+    {23.0, 6, 3.0 / 4.0},
+    {25.0, 6, 5.0 / 6.0},
+    {29.0, 8, 3.0 / 4.0},  // 256-QAM
+    {31.0, 8, 5.0 / 6.0},
+};
+
+}
+
+MobilityModel::MobilityModel(const MobilityConfig& cfg, size_t stationCount)
+    : config(cfg), rng(cfg.seed),
+      x(stationCount), y(stationCount), vx(stationCount, 0.0), vy(stationCount, 0.0),
+      targetX(stationCount), targetY(stationCount), rateX(stationCount), rateY(stationCount),
+      links(stationCount), cellOf(stationCount), slotInCell(stationCount), lastUpdate(0.0),
+      stale(stationCount, 0) {
+    columns = std::max(1, static_cast<int>(std::ceil(config.areaWidth / config.gridCellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(config.areaHeight / config.gridCellSize)));
+    cells.resize(static_cast<size_t>(columns) * rows);
+
+    std::uniform_real_distribution<double> px(0.0, config.areaWidth);
+    std::uniform_real_distribution<double> py(0.0, config.areaHeight);
+    std::uniform_real_distribution<double> heading(0.0, 2.0 * M_PI);
+    double speedPerMs = config.speed / 1000.0;
+
+    for (size_t i = 0; i < stationCount; ++i) {
+        x[i] = px(rng);
+        y[i] = py(rng);
+        rateX[i] = x[i];
+        rateY[i] = y[i];
+        double angle = heading(rng);
+        vx[i] = speedPerMs * std::cos(angle);
+        vy[i] = speedPerMs * std::sin(angle);
+        pickWaypoint(i);
+        insertIntoGrid(i);
+    }
+
+    nextUpdate = config.pattern == MobilityPattern::Static
+                     ? std::numeric_limits<double>::infinity()
+                     : config.updateInterval;
+}
+
+uint32_t MobilityModel::cellIndex(double px, double py) const {
+    int cx = std::clamp(static_cast<int>(px / config.gridCellSize), 0, columns - 1);
+    int cy = std::clamp(static_cast<int>(py / config.gridCellSize), 0, rows - 1);
+    return static_cast<uint32_t>(cy * columns + cx);
+}
+
+void MobilityModel::insertIntoGrid(size_t station) {
+    uint32_t cell = cellIndex(x[station], y[station]);
+    cellOf[station] = cell;
+    slotInCell[station] = static_cast<uint32_t>(cells[cell].size());
+    cells[cell].push_back(static_cast<uint32_t>(station));
+}
+
+void MobilityModel::removeFromGrid(size_t station) {
+    // Swap-remove keeps removal O(1)
+    std::vector<uint32_t>& cell = cells[cellOf[station]];
+    uint32_t slot = slotInCell[station];
+    uint32_t last = cell.back();
+    cell[slot] = last;
+    slotInCell[last] = slot;
+    cell.pop_back();
+}
+
+void MobilityModel::pickWaypoint(size_t station) {
+    std::uniform_real_distribution<double> px(0.0, config.areaWidth);
+    std::uniform_real_distribution<double> py(0.0, config.areaHeight);
+    targetX[station] = px(rng);
+    targetY[station] = py(rng);
+}
+
+void MobilityModel::moveStation(size_t i, double dtMs) {
+    if (config.pattern == MobilityPattern::Linear) {
+        x[i] += vx[i] * dtMs;
+        y[i] += vy[i] * dtMs;
+        if (x[i] < 0.0 || x[i] > config.areaWidth) {
+            vx[i] = -vx[i];
+            x[i] = std::clamp(x[i], 0.0, config.areaWidth);
+        }
+        if (y[i] < 0.0 || y[i] > config.areaHeight) {
+            vy[i] = -vy[i];
+            y[i] = std::clamp(y[i], 0.0, config.areaHeight);
+        }
+    } else if (config.pattern == MobilityPattern::RandomWaypoint) {
+        double dx = targetX[i] - x[i];
+        double dy = targetY[i] - y[i];
+        double distance = std::hypot(dx, dy);
+        double step = config.speed / 1000.0 * dtMs;
+        if (step >= distance) {
+            x[i] = targetX[i];
+            y[i] = targetY[i];
+            pickWaypoint(i);
+        } else {
+            x[i] += dx / distance * step;
+            y[i] += dy / distance * step;
+        }
+    }
+}
+
+template <typename Visit>
+void MobilityModel::forEachNeighbour(size_t station, double px, double py, double radius, Visit visit) const {
+    // Only the grid cells overlapping the search square are visited
+    double r2 = radius * radius;
+    int minX = std::max(0, static_cast<int>((px - radius) / config.gridCellSize));
+    int maxX = std::min(columns - 1, static_cast<int>((px + radius) / config.gridCellSize));
+    int minY = std::max(0, static_cast<int>((py - radius) / config.gridCellSize));
+    int maxY = std::min(rows - 1, static_cast<int>((py + radius) / config.gridCellSize));
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            for (uint32_t other : cells[static_cast<size_t>(cy) * columns + cx]) {
+                if (other == station) continue;
+                double dx = x[other] - px;
+                double dy = y[other] - py;
+                if (dx * dx + dy * dy <= r2) visit(other);
+            }
+        }
+    }
+}
+
+void MobilityModel::neighbours(size_t station, double radius, std::vector<size_t>& out) const {
+    out.clear();
+    forEachNeighbour(station, x[station], y[station], radius, [&out](uint32_t other) { out.push_back(other); });
+}
+
+void MobilityModel::evaluateLink(size_t station) {
+    // Log-distance path loss, plus a noise rise from nearby contending stations
+    double distance = std::max(1.0, std::hypot(x[station] - config.apX, y[station] - config.apY));
+    double pathLoss = config.referenceLoss + 10.0 * config.pathLossExponent * std::log10(distance);
+    size_t crowd = 0;
+    forEachNeighbour(station, x[station], y[station], config.interferenceRadius, [&crowd](uint32_t) { ++crowd; });
+    double noiseRise = 10.0 * std::log10(1.0 + config.interferenceFactor * crowd);
+    double snr = config.txPower - pathLoss - config.noiseFloor - noiseRise;
+
+    Link& link = links[station];
+    link.snrDb = snr;
+    link.usable = false;
+    link.modulationBits = 0;
+    link.codingRate = 0.0;
+    for (const McsEntry& mcs : MCS_TABLE) {
+        if (snr < mcs.minSnr) break;
+        link.usable = true;
+        link.modulationBits = mcs.modulationBits;
+        link.codingRate = mcs.codingRate;
+    }
+    link.beamformable = link.usable && snr >= config.beamformingSnr;
+
+    rateX[station] = x[station];
+    rateY[station] = y[station];
+}
+
+void MobilityModel::placeStation(size_t station, double px, double py) {
+    removeFromGrid(station);
+    x[station] = std::clamp(px, 0.0, config.areaWidth);
+    y[station] = std::clamp(py, 0.0, config.areaHeight);
+    insertIntoGrid(station);
+}
+
+void MobilityModel::evaluateAllLinks() {
+    changed.clear();
+    for (size_t i = 0; i < links.size(); ++i) {
+        evaluateLink(i);
+        changed.push_back(i);
+    }
+}
+
+void MobilityModel::markNeighboursStale(size_t station, double px, double py) {
+    forEachNeighbour(station, px, py, config.interferenceRadius, [this](uint32_t other) { stale[other] = 1; });
+}
+
+void MobilityModel::advanceTo(double now) {
+    changed.clear();
+    if (nextUpdate > now) return;
+
+    while (nextUpdate <= now) {
+        double dt = nextUpdate - lastUpdate;
+        crossings.clear();
+        for (size_t i = 0; i < x.size(); ++i) {
+            double fromX = x[i];
+            double fromY = y[i];
+            moveStation(i, dt);
+            if (cellIndex(x[i], y[i]) != cellOf[i]) {
+                removeFromGrid(i);
+                insertIntoGrid(i);
+                crossings.push_back({static_cast<uint32_t>(i), fromX, fromY});
+            }
+        }
+        // Once everyone has moved, the stations around where a crosser left
+        // and where it arrived may count a different crowd
+        for (const CellCrossing& crossing : crossings) {
+            stale[crossing.station] = 1;
+            markNeighboursStale(crossing.station, crossing.fromX, crossing.fromY);
+            markNeighboursStale(crossing.station, x[crossing.station], y[crossing.station]);
+        }
+        lastUpdate = nextUpdate;
+        nextUpdate += config.updateInterval;
+    }
+
+    double threshold2 = config.rateThreshold * config.rateThreshold;
+    for (size_t i = 0; i < x.size(); ++i) {
+        double dx = x[i] - rateX[i];
+        double dy = y[i] - rateY[i];
+        if (dx * dx + dy * dy > threshold2) {
+            stale[i] = 1;
+            markNeighboursStale(i, rateX[i], rateY[i]);
+            markNeighboursStale(i, x[i], y[i]);
+        }
+    }
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (!stale[i]) continue;
+        stale[i] = 0;
+        evaluateLink(i);
+        changed.push_back(i);
+    }
+}
+
+double MobilityModel::nextUpdateTime() const { return nextUpdate; }
+const std::vector<size_t>& MobilityModel::changedStations() const { return changed; }
+const Link& MobilityModel::link(size_t station) const { return links[station]; }
+double MobilityModel::getX(size_t station) const { return x[station]; }
+double MobilityModel::getY(size_t station) const { return y[station]; }
+size_t MobilityModel::size() const { return x.size(); }
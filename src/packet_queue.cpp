@@ -0,0 +1,97 @@
+#include "../include/packet_queue.h"
+#include <cmath>
+
+PacketQueue::PacketQueue(const QueueConfig& config, double rate)
+    : buffer(config.capacity), aqm(config.aqm), target(config.codelTarget),
+      interval(config.codelInterval), arrivalRate(rate), nextArrival(0.0),
+      dropping(false), firstAboveTime(0.0), dropNext(0.0), count(0), lastCount(0),
+      enqueued(0), tailDrops(0), aqmDrops(0) {}
+
+bool PacketQueue::arrivalsDue(double now) const {
+    if (arrivalRate == SATURATED) return !buffer.full();
+    return arrivalRate > 0.0 && nextArrival <= now;
+}
+
+void PacketQueue::offer(double now, int size, int src, int dest) {
+    if (arrivalRate == SATURATED) {
+        while (buffer.push({size, src, dest, now})) {
+            ++enqueued;
+        }
+        return;
+    }
+    if (arrivalRate <= 0.0) return;
+
+    // The queue only drains when served, so replaying the arrivals since the
+    // last service in one batch gives the same drops as simulating each one
+    double spacing = 1.0 / arrivalRate;
+    while (nextArrival <= now) {
+        if (buffer.push({size, src, dest, nextArrival})) {
+            ++enqueued;
+        } else {
+            ++tailDrops;
+        }
+        nextArrival += spacing;
+    }
+}
+
+double PacketQueue::controlLaw(double t) const {
+    return t + interval / std::sqrt(static_cast<double>(count));
+}
+
+bool PacketQueue::codelOkToDrop(const QueuedPacket& head, double now) {
+    double sojourn = now - head.enqueueTime;
+    if (sojourn < target || buffer.empty()) {
+        firstAboveTime = 0.0;
+        return false;
+    }
+    if (firstAboveTime == 0.0) {
+        firstAboveTime = now + interval;
+        return false;
+    }
+    return now >= firstAboveTime;
+}
+
+bool PacketQueue::dequeue(double now, QueuedPacket& out) {
+    while (!buffer.empty()) {
+        QueuedPacket head = buffer.front();
+        buffer.pop();
+
+        if (aqm == AqmMode::CoDel) {
+            bool okToDrop = codelOkToDrop(head, now);
+            if (dropping) {
+                if (!okToDrop) {
+                    dropping = false;
+                } else if (now >= dropNext) {
+                    ++aqmDrops;
+                    ++count;
+                    dropNext = controlLaw(dropNext);
+                    continue;
+                }
+            } else if (okToDrop) {
+                ++aqmDrops;
+                dropping = true;
+                unsigned delta = count - lastCount;
+                count = (delta > 1 && now - dropNext < 16 * interval) ? delta : 1;
+                dropNext = controlLaw(now);
+                lastCount = count;
+                continue;
+            }
+        }
+
+        out = head;
+        return true;
+    }
+    dropping = false;
+    return false;
+}
+
+double PacketQueue::readyTime(double now) const {
+    if (!buffer.empty() || arrivalRate == SATURATED) return now;
+    if (arrivalRate > 0.0) return nextArrival > now ? nextArrival : now;
+    return -1.0;
+}
+
+size_t PacketQueue::size() const { return buffer.size(); }
+long PacketQueue::getEnqueued() const { return enqueued; }
+long PacketQueue::getTailDrops() const { return tailDrops; }
+long PacketQueue::getAqmDrops() const { return aqmDrops; }
@@ -0,0 +1,101 @@
+#include "../include/result_cache.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+const uint32_t ENTRY_MAGIC = 0x43525357; // "WSRC"
+
+struct EntryHeader {
+    uint32_t magic;
+    uint32_t recordSize;
+    uint64_t key;
+};
+
+}
+
+ResultCache::ResultCache(const std::string& dir) : directory(dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    loadIndex();
+}
+
+uint64_t ResultCache::makeKey(const std::string& config) {
+    // 64-bit FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const std::string& text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(SIMULATOR_VERSION);
+    mix(std::string(1, '\0'));
+    mix(config);
+    return hash;
+}
+
+std::string ResultCache::entryPath(uint64_t key) const {
+    std::ostringstream name;
+    name << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    return name.str();
+}
+
+std::string ResultCache::indexPath() const {
+    return directory + "/index";
+}
+
+void ResultCache::loadIndex() {
+    std::ifstream in(indexPath(), std::ios::binary | std::ios::ate);
+    if (!in) return;
+
+    std::streamsize bytes = in.tellg();
+    std::vector<uint64_t> keys(static_cast<size_t>(bytes) / sizeof(uint64_t));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(keys.data()), keys.size() * sizeof(uint64_t));
+
+    index.reserve(keys.size());
+    index.insert(keys.begin(), keys.end());
+}
+
+bool ResultCache::lookup(uint64_t key, ProtocolResult& result) const {
+    if (index.find(key) == index.end()) return false;
+
+    std::ifstream in(entryPath(key), std::ios::binary);
+    EntryHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (header.magic != ENTRY_MAGIC || header.recordSize != sizeof(ProtocolResult) || header.key != key) {
+        return false;
+    }
+
+    ProtocolResult cached{};
+    if (!in.read(reinterpret_cast<char*>(&cached), sizeof(cached))) return false;
+    result = cached;
+    return true;
+}
+
+void ResultCache::store(uint64_t key, const ProtocolResult& result) {
+    // Write to a temporary file first so a crash never leaves a torn entry
+    std::string path = entryPath(key);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) return;
+        EntryHeader header{ENTRY_MAGIC, static_cast<uint32_t>(sizeof(ProtocolResult)), key};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(&result), sizeof(result));
+        if (!out) return;
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) return;
+
+    if (index.insert(key).second) {
+        std::ofstream idx(indexPath(), std::ios::binary | std::ios::app);
+        idx.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    }
+}
+
+size_t ResultCache::size() const { return index.size(); }
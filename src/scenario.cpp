@@ -0,0 +1,266 @@
+#include "../include/scenario.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0' && std::isfinite(value);
+}
+
+bool parseInt(const std::string& text, int& value) {
+    char* end = nullptr;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    value = static_cast<int>(parsed);
+    return end != text.c_str() && *end == '\0' && parsed >= INT_MIN && parsed <= INT_MAX;
+}
+
+bool parseRate(const std::string& text, double& value) {
+    if (text == "saturated") {
+        value = SATURATED;
+        return true;
+    }
+    return parseDouble(text, value) && value >= 0.0;
+}
+
+namespace {
+
+// Comma-separated list of positive integers (user counts, RU sizes)
+bool parseIntList(const std::string& text, std::vector<int>& values) {
+    std::vector<int> parsed;
+    std::istringstream items(text);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        int value;
+        if (!parseInt(trim(item), value) || value <= 0) return false;
+        parsed.push_back(value);
+    }
+    if (parsed.empty()) return false;
+    values = parsed;
+    return true;
+}
+
+// A decimal or an exact fraction such as "5/6"
+bool parseRatio(const std::string& text, double& value) {
+    size_t slash = text.find('/');
+    if (slash == std::string::npos) return parseDouble(text, value);
+    double numerator, denominator;
+    if (!parseDouble(trim(text.substr(0, slash)), numerator)) return false;
+    if (!parseDouble(trim(text.substr(slash + 1)), denominator) || denominator == 0.0) return false;
+    value = numerator / denominator;
+    return true;
+}
+
+bool applySetting(ScenarioConfig& config, const std::string& section, const std::string& key,
+                  const std::string& value) {
+    ProtocolParams& p = config.params;
+    QueueConfig& q = config.queue;
+
+    if (section == "simulation") {
+        if (key == "duration") return parseDouble(value, p.duration) && p.duration > 0.0;
+        if (key == "users") return parseIntList(value, config.userCounts);
+        if (key == "seed") {
+            int seed;
+            if (!parseInt(value, seed) || seed < 0) return false;
+            config.seed = static_cast<unsigned>(seed);
+            return true;
+        }
+        if (key == "access_points") {
+            std::vector<std::string> names;
+            std::istringstream items(value);
+            std::string item;
+            while (std::getline(items, item, ',')) {
+                item = trim(item);
+                if (item != "wifi4" && item != "wifi5" && item != "wifi6") return false;
+                names.push_back(item);
+            }
+            if (names.empty()) return false;
+            config.accessPoints = names;
+            return true;
+        }
+    } else if (section == "phy") {
+        if (key == "bandwidth") return parseDouble(value, p.bandwidth) && p.bandwidth > 0.0;
+        if (key == "modulation_bits") return parseInt(value, p.modulationBits) && p.modulationBits > 0;
+        if (key == "coding_rate") return parseRatio(value, p.codingRate) && p.codingRate > 0.0 && p.codingRate <= 1.0;
+    } else if (section == "traffic") {
+        if (key == "packet_size") return parseInt(value, p.packetSize) && p.packetSize > 0;
+        if (key == "uplink_rate") return parseRate(value, q.uplinkRate);
+        if (key == "downlink_rate") return parseRate(value, q.downlinkRate);
+    } else if (section == "queue") {
+        if (key == "capacity") {
+            int capacity;
+            if (!parseInt(value, capacity) || capacity <= 0) return false;
+            q.capacity = static_cast<size_t>(capacity);
+            return true;
+        }
+        if (key == "aqm") {
+            if (value == "droptail") q.aqm = AqmMode::DropTail;
+            else if (value == "codel") q.aqm = AqmMode::CoDel;
+            else return false;
+            return true;
+        }
+        if (key == "codel_target") return parseDouble(value, q.codelTarget) && q.codelTarget > 0.0;
+        if (key == "codel_interval") return parseDouble(value, q.codelInterval) && q.codelInterval > 0.0;
+    } else if (section == "wifi5") {
+        if (key == "csi_size") return parseInt(value, p.csiSize) && p.csiSize > 0;
+        if (key == "parallel_window") return parseDouble(value, p.parallelTime) && p.parallelTime > 0.0;
+    } else if (section == "wifi6") {
+        if (key == "allocation_window") return parseDouble(value, p.allocationTime) && p.allocationTime > 0.0;
+        if (key == "sub_channels") return parseIntList(value, p.subChannelSizes);
+    } else if (section == "mobility") {
+        MobilityConfig& m = config.mobility;
+        if (key == "enabled") {
+            if (value == "true") m.enabled = true;
+            else if (value == "false") m.enabled = false;
+            else return false;
+            return true;
+        }
+        if (key == "pattern") {
+            if (value == "static") m.pattern = MobilityPattern::Static;
+            else if (value == "linear") m.pattern = MobilityPattern::Linear;
+            else if (value == "random_waypoint") m.pattern = MobilityPattern::RandomWaypoint;
+            else return false;
+            return true;
+        }
+        if (key == "area_width") return parseDouble(value, m.areaWidth) && m.areaWidth > 0.0;
+        if (key == "area_height") return parseDouble(value, m.areaHeight) && m.areaHeight > 0.0;
+        if (key == "ap_x") return parseDouble(value, m.apX);
+        if (key == "ap_y") return parseDouble(value, m.apY);
+        if (key == "speed") return parseDouble(value, m.speed) && m.speed >= 0.0;
+        if (key == "update_interval") return parseDouble(value, m.updateInterval) && m.updateInterval > 0.0;
+        if (key == "rate_threshold") return parseDouble(value, m.rateThreshold) && m.rateThreshold >= 0.0;
+        if (key == "grid_cell") return parseDouble(value, m.gridCellSize) && m.gridCellSize > 0.0;
+        if (key == "interference_radius") return parseDouble(value, m.interferenceRadius) && m.interferenceRadius >= 0.0;
+        if (key == "interference_factor") return parseDouble(value, m.interferenceFactor) && m.interferenceFactor >= 0.0;
+        if (key == "tx_power") return parseDouble(value, m.txPower);
+        if (key == "reference_loss") return parseDouble(value, m.referenceLoss);
+        if (key == "path_loss_exponent") return parseDouble(value, m.pathLossExponent) && m.pathLossExponent > 0.0;
+        if (key == "noise_floor") return parseDouble(value, m.noiseFloor);
+        if (key == "beamforming_snr") return parseDouble(value, m.beamformingSnr);
+        if (key == "seed") {
+            int seed;
+            if (!parseInt(value, seed)) return false;
+            m.seed = static_cast<unsigned>(seed);
+            return true;
+        }
+    } else if (section == "stations") {
+        if (key == "table") {
+            config.stationTable = value;
+            return !value.empty();
+        }
+    }
+    return false;
+}
+
+}
+
+bool loadScenario(const std::string& path, ScenarioConfig& config, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "cannot open scenario " + path;
+        return false;
+    }
+
+    std::string section;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::string where = path + ":" + std::to_string(lineNumber) + ": ";
+        if (line.front() == '[') {
+            if (line.back() != ']') {
+                error = where + "malformed section header";
+                return false;
+            }
+            section = trim(line.substr(1, line.size() - 2));
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = where + "expected key = value";
+            return false;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+        if (!applySetting(config, section, key, value)) {
+            error = where + "invalid setting '" + key + "' in [" + section + "]";
+            return false;
+        }
+    }
+
+    // Sidecar paths are relative to the scenario file
+    if (!config.stationTable.empty()) {
+        std::filesystem::path table(config.stationTable);
+        if (table.is_relative()) {
+            config.stationTable = (std::filesystem::path(path).parent_path() / table).string();
+        }
+    }
+    return true;
+}
+
+std::string describeScenario(const ScenarioConfig& config, const std::string& accessPoint) {
+    const ProtocolParams& p = config.params;
+    const QueueConfig& q = config.queue;
+    const MobilityConfig& m = config.mobility;
+    std::ostringstream out;
+    // Enough digits to round-trip every double, so distinct settings never share a key
+    out << std::setprecision(17);
+    out << "ap=" << accessPoint;
+
+    // Only the knobs this protocol reads, so tuning one protocol keeps the
+    // others' cached results
+    if (accessPoint == "wifi4") {
+        out << ";seed=" << config.seed; // drives CSMA/CA backoff
+    } else if (accessPoint == "wifi5") {
+        out << ";csi=" << p.csiSize << ";parallel=" << p.parallelTime;
+        if (m.enabled) out << ";beamforming=" << m.beamformingSnr;
+    } else if (accessPoint == "wifi6") {
+        out << ";allocation=" << p.allocationTime << ";subchannels=";
+        for (int size : p.subChannelSizes) out << size << ",";
+    }
+
+    out << ";duration=" << p.duration << ";bw=" << p.bandwidth << ";mod=" << p.modulationBits
+        << ";coding=" << p.codingRate << ";packet=" << p.packetSize;
+    out << ";queue=" << q.capacity
+        << ";aqm=" << (q.aqm == AqmMode::CoDel ? "codel" : "droptail")
+        << ";target=" << q.codelTarget << ";interval=" << q.codelInterval
+        << ";uplink=" << q.uplinkRate << ";downlink=" << q.downlinkRate;
+
+    if (m.enabled) {
+        out << ";mobility=" << static_cast<int>(m.pattern) << "," << m.areaWidth << "," << m.areaHeight
+            << "," << m.apX << "," << m.apY << "," << m.speed << "," << m.updateInterval
+            << "," << m.rateThreshold << "," << m.gridCellSize << "," << m.interferenceRadius
+            << "," << m.interferenceFactor << "," << m.txPower << "," << m.referenceLoss
+            << "," << m.pathLossExponent << "," << m.noiseFloor << "," << m.seed;
+    }
+
+    // Identify the station table by path, size and modification time rather
+    // than hashing what may be millions of records
+    if (!config.stationTable.empty()) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(config.stationTable, ec);
+        auto modified = std::filesystem::last_write_time(config.stationTable, ec);
+        out << ";stations=" << config.stationTable << "@" << size << "@"
+            << modified.time_since_epoch().count();
+    }
+    return out.str();
+}
@@ -0,0 +1,91 @@
+#include "../include/simulation.h"
+#include <cmath>
+#include <memory>
+#include "../include/metrics.h"
+#include "../include/wifi4.h"
+#include "../include/wifi5.h"
+#include "../include/wifi6.h"
+
+std::pair<double, double> queueingDelay(const AccessPoint& ap) {
+    LatencyHistogram delay = ap.getUplinkQueueingDelay();
+    delay.merge(ap.getDownlinkQueueingDelay());
+    return {delay.percentile(50.0), delay.percentile(99.0)};
+}
+
+namespace {
+
+template <typename AP, typename StationUser>
+ProtocolResult runAccessPoint(const ScenarioConfig& config, const StationTable& stations, int numUsers) {
+    auto ap = std::make_unique<AP>(1);
+    ap->setProtocolParams(config.params);
+    ap->setQueueConfig(config.queue);
+    for (int i = 0; i < numUsers; ++i) {
+        std::unique_ptr<StationUser> user;
+        if (static_cast<size_t>(i) < stations.size()) {
+            const StationRecord& station = stations[i];
+            int size = station.packetSize > 0 ? station.packetSize : config.params.packetSize;
+            user = std::make_unique<StationUser>(station.id, size);
+            user->seed(config.seed + static_cast<unsigned>(i));
+            ap->addUser(std::move(user), station.uplinkRate, station.downlinkRate);
+        } else {
+            user = std::make_unique<StationUser>(i, config.params.packetSize);
+            user->seed(config.seed + static_cast<unsigned>(i));
+            ap->addUser(std::move(user));
+        }
+    }
+    if (config.mobility.enabled) {
+        // Same seed for every protocol, so they all see the same trajectories
+        auto mobility = std::make_unique<MobilityModel>(config.mobility, static_cast<size_t>(numUsers));
+        for (int i = 0; i < numUsers && static_cast<size_t>(i) < stations.size(); ++i) {
+            if (!std::isnan(stations[i].x) && !std::isnan(stations[i].y)) {
+                mobility->placeStation(i, stations[i].x, stations[i].y);
+            }
+        }
+        ap->setMobility(std::move(mobility));
+    }
+    ap->simulateTransmission();
+
+    ProtocolResult r;
+    r.throughput = ap->computeThroughput();
+    auto [avgLat, maxLat] = ap->computeLatency();
+    r.avgLatency = avgLat;
+    r.maxLatency = maxLat;
+    auto [p50, p99] = queueingDelay(*ap);
+    r.queueP50 = p50;
+    r.queueP99 = p99;
+    r.packets = ap->getTransmittedPackets().size();
+    simulationMetrics().scenariosCompleted.fetch_add(1, std::memory_order_relaxed);
+    return r;
+}
+
+} // namespace
+
+ProtocolResult runProtocol(const std::string& name, const ScenarioConfig& config, const StationTable& stations,
+                           int numUsers) {
+    if (name == "wifi4") return runAccessPoint<WiFi4AccessPoint, WiFi4User>(config, stations, numUsers);
+    if (name == "wifi5") return runAccessPoint<WiFi5AccessPoint, WiFi5User>(config, stations, numUsers);
+    if (name == "wifi6") return runAccessPoint<WiFi6AccessPoint, WiFi6User>(config, stations, numUsers);
+    return ProtocolResult{};
+}
+
+void storeProtocolResult(Result& result, const std::string& name, const ProtocolResult& r) {
+    if (name == "wifi4") {
+        result.wifi4Throughput = r.throughput;
+        result.wifi4AvgLatency = r.avgLatency;
+        result.wifi4MaxLatency = r.maxLatency;
+        result.wifi4QueueP50 = r.queueP50;
+        result.wifi4QueueP99 = r.queueP99;
+    } else if (name == "wifi5") {
+        result.wifi5Throughput = r.throughput;
+        result.wifi5AvgLatency = r.avgLatency;
+        result.wifi5MaxLatency = r.maxLatency;
+        result.wifi5QueueP50 = r.queueP50;
+        result.wifi5QueueP99 = r.queueP99;
+    } else if (name == "wifi6") {
+        result.wifi6Throughput = r.throughput;
+        result.wifi6AvgLatency = r.avgLatency;
+        result.wifi6MaxLatency = r.maxLatency;
+        result.wifi6QueueP50 = r.queueP50;
+        result.wifi6QueueP99 = r.queueP99;
+    }
+}
@@ -0,0 +1,164 @@
+#include "../include/station_table.h"
+#include "../include/packet_queue.h"
+#include "../include/scenario.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t TABLE_MAGIC = 0x54535357; // "WSST"
+const uint32_t TABLE_VERSION = 2;
+
+struct TableHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+}
+
+StationTable::StationTable() : mapping(nullptr), mappingSize(0), records(nullptr), count(0) {}
+
+StationTable::~StationTable() { close(); }
+
+void StationTable::close() {
+    if (mapping) munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    count = 0;
+}
+
+bool StationTable::open(const std::string& path, std::string& error) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open station table " + path;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(TableHeader)) {
+        ::close(fd);
+        error = "station table " + path + " is truncated";
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        error = "cannot map station table " + path;
+        return false;
+    }
+
+    const TableHeader* header = static_cast<const TableHeader*>(data);
+    if (header->magic != TABLE_MAGIC || header->version != TABLE_VERSION
+        || header->recordSize != sizeof(StationRecord)
+        || header->count > (size - sizeof(TableHeader)) / sizeof(StationRecord)) {
+        munmap(data, size);
+        error = "station table " + path + " has an unsupported format";
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = size;
+    records = reinterpret_cast<const StationRecord*>(static_cast<const char*>(data) + sizeof(TableHeader));
+    count = static_cast<size_t>(header->count);
+    return true;
+}
+
+size_t StationTable::size() const { return count; }
+
+const StationRecord& StationTable::operator[](size_t index) const { return records[index]; }
+
+bool writeStationTable(const std::string& path, const std::vector<StationRecord>& stations, std::string& error) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        error = "cannot write station table " + path;
+        return false;
+    }
+    TableHeader header{TABLE_MAGIC, TABLE_VERSION, static_cast<uint32_t>(sizeof(StationRecord)), 0, stations.size()};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(stations.data()), stations.size() * sizeof(StationRecord));
+    if (!out) {
+        error = "failed writing station table " + path;
+        return false;
+    }
+    return true;
+}
+
+bool convertStationTable(const std::string& csvPath, const std::string& binaryPath, std::string& error) {
+    std::ifstream in(csvPath);
+    if (!in) {
+        error = "cannot open " + csvPath;
+        return false;
+    }
+
+    std::vector<StationRecord> stations;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        // Count separators rather than fields read, so trailing extras are caught too
+        int n = static_cast<int>(std::count(line.begin(), line.end(), ',')) + 1;
+        if (n != 4 && n != 6) {
+            error = csvPath + ":" + std::to_string(lineNumber) + ": expected 4 or 6 fields, got "
+                    + std::to_string(n);
+            return false;
+        }
+        std::istringstream fields(line);
+        std::string field[6];
+        for (int i = 0; i < n; ++i) std::getline(fields, field[i], ',');
+
+        std::string where = csvPath + ":" + std::to_string(lineNumber) + ": ";
+        for (int i = 0; i < n; ++i) field[i] = trim(field[i]);
+
+        int id, packetSize;
+        double uplinkRate, downlinkRate, x = NAN, y = NAN;
+        if (!parseInt(field[0], id)) {
+            error = where + "invalid station id '" + field[0] + "'";
+            return false;
+        }
+        if (!parseInt(field[1], packetSize) || packetSize < 0) {
+            error = where + "invalid packet size '" + field[1] + "'";
+            return false;
+        }
+        if (!parseRate(field[2], uplinkRate)) {
+            error = where + "invalid uplink rate '" + field[2] + "'";
+            return false;
+        }
+        if (!parseRate(field[3], downlinkRate)) {
+            error = where + "invalid downlink rate '" + field[3] + "'";
+            return false;
+        }
+        if (n == 6 && (!parseDouble(field[4], x) || !parseDouble(field[5], y))) {
+            error = where + "invalid position '" + field[4] + "," + field[5] + "'";
+            return false;
+        }
+
+        StationRecord record{};
+        record.id = id;
+        record.packetSize = packetSize;
+        record.uplinkRate = static_cast<float>(uplinkRate);
+        record.downlinkRate = static_cast<float>(downlinkRate);
+        record.x = static_cast<float>(x);
+        record.y = static_cast<float>(y);
+        stations.push_back(record);
+    }
+    return writeStationTable(binaryPath, stations, error);
+}
@@ -1,5 +1,9 @@
 #include "../include/user.h"
-#include <chrono>
 
-User::User(int userId) : id(userId), rng(std::chrono::steady_clock::now().time_since_epoch().count()) {}
+User::User(int userId, int size) : id(userId), packetSize(size), rng(static_cast<unsigned>(userId)) {}
 int User::getId() const { return id; }
+int User::getPacketSize() const { return packetSize; }
+PacketQueue& User::getUplinkQueue() { return uplinkQueue; }
+void User::seed(unsigned value) { rng.seed(value); }
+const Link& User::getLink() const { return link; }
+void User::setLink(const Link& l) { link = l; }
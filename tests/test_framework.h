@@ -0,0 +1,51 @@
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Minimal self-registering test harness; the runner is in test_main.cpp
+
+struct TestCase {
+    const char* name;
+    void (*body)();
+};
+
+std::vector<TestCase>& testRegistry();
+void reportFailure(const char* file, int line, const std::string& message);
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*body)()) { testRegistry().push_back({name, body}); }
+};
+
+// Settings the runner takes from its command line
+struct TestOptions {
+    bool recordPerfBaseline = false;
+    std::string perfBaselinePath = "tests/perf_baseline.txt";
+    double perfTolerance = 0.5; // fraction of the baseline event rate that may be lost
+};
+
+TestOptions& testOptions();
+
+#define TEST(name)                                               \
+    static void name();                                          \
+    static TestRegistrar name##Registrar(#name, name);           \
+    static void name()
+
+#define CHECK(condition)                                         \
+    do {                                                         \
+        if (!(condition)) reportFailure(__FILE__, __LINE__, #condition); \
+    } while (0)
+
+// Relative tolerance, falling back to absolute near zero
+#define CHECK_NEAR(actual, expected, tolerance)                                              \
+    do {                                                                                     \
+        double a_ = (actual), e_ = (expected);                                               \
+        if (std::fabs(a_ - e_) > (tolerance) * std::fmax(1.0, std::fabs(e_))) {              \
+            reportFailure(__FILE__, __LINE__, std::string(#actual) + " = " + std::to_string(a_) \
+                                                  + ", expected " + std::to_string(e_));     \
+        }                                                                                    \
+    } while (0)
+
+#endif // TEST_FRAMEWORK_H
@@ -0,0 +1,89 @@
+#include <memory>
+#include "./test_framework.h"
+#include "../include/simulation.h"
+#include "../include/wifi4.h"
+
+// Results pinned for the default seeds. A model change that moves them is
+// intentional only if these values and SIMULATOR_VERSION change with it.
+
+namespace {
+
+struct GoldenResult {
+    const char* accessPoint;
+    int users;
+    double throughput, avgLatency, maxLatency, queueP50, queueP99;
+    size_t packets;
+};
+
+const GoldenResult DEFAULT_SCENARIO[] = {
+    {"wifi4", 1, 133.332992, 999.99744, 999.99744, 3.871, 3.871, 16276},
+    {"wifi5", 1, 1.186944, 5.02448, 15, 483.327, 949.627, 198},
+    {"wifi6", 1, 34.799616, 0.231412429, 0.6144, 14.877, 14.877, 4248},
+    {"wifi4", 10, 133.332992, 99.999744, 100.02432, 38.707, 38.707, 16276},
+    {"wifi5", 10, 6.89728, 7.15149714, 15, 487.423, 956.431, 1365},
+    {"wifi6", 10, 105.054208, 0.230735371, 0.6144, 49.877, 49.877, 12824},
+    {"wifi4", 100, 133.332992, 9.9999744, 10.01472, 387.072, 387.072, 16276},
+    {"wifi5", 100, 60.230912, 7.46896239, 15, 491.519, 975.686, 12261},
+    {"wifi6", 100, 105.054208, 0.230735371, 0.6144, 339.967, 499.877, 12824},
+};
+
+// 20 stations on random-waypoint trajectories (mobility seed 1)
+const GoldenResult MOBILE_SCENARIO[] = {
+    {"wifi4", 20, 23.1424, 49.987584, 135.9872, 380.927, 386.785, 2825},
+    {"wifi5", 20, 6.56032, 4.62559385, 15, 491.519, 961.723, 1690},
+    {"wifi6", 20, 35.069952, 0.585978146, 4.096, 141.311, 827.391, 4281},
+};
+
+const double TOLERANCE = 1e-6;
+
+void checkGolden(const ScenarioConfig& config, const GoldenResult& golden) {
+    StationTable stations;
+    ProtocolResult r = runProtocol(golden.accessPoint, config, stations, golden.users);
+    CHECK_NEAR(r.throughput, golden.throughput, TOLERANCE);
+    CHECK_NEAR(r.avgLatency, golden.avgLatency, TOLERANCE);
+    CHECK_NEAR(r.maxLatency, golden.maxLatency, TOLERANCE);
+    CHECK_NEAR(r.queueP50, golden.queueP50, TOLERANCE);
+    CHECK_NEAR(r.queueP99, golden.queueP99, TOLERANCE);
+    CHECK(r.packets == golden.packets);
+}
+
+} // namespace
+
+TEST(golden_default_scenario) {
+    ScenarioConfig config;
+    for (const GoldenResult& golden : DEFAULT_SCENARIO) checkGolden(config, golden);
+}
+
+TEST(golden_mobile_scenario) {
+    ScenarioConfig config;
+    config.mobility.enabled = true;
+    config.mobility.pattern = MobilityPattern::RandomWaypoint;
+    for (const GoldenResult& golden : MOBILE_SCENARIO) checkGolden(config, golden);
+}
+
+TEST(golden_repeatable_runs) {
+    ScenarioConfig config;
+    config.mobility.enabled = true;
+    config.mobility.pattern = MobilityPattern::Linear;
+    config.queue.downlinkRate = 0.05;
+    StationTable stations;
+    for (const auto& name : config.accessPoints) {
+        ProtocolResult first = runProtocol(name, config, stations, 30);
+        ProtocolResult second = runProtocol(name, config, stations, 30);
+        CHECK(first.throughput == second.throughput);
+        CHECK(first.avgLatency == second.avgLatency);
+        CHECK(first.queueP99 == second.queueP99);
+        CHECK(first.packets == second.packets);
+    }
+}
+
+TEST(golden_backoff_follows_seed) {
+    WiFi4User a(1), b(2);
+    a.seed(42);
+    b.seed(42);
+    for (int i = 0; i < 8; ++i) {
+        a.incrementBackoff();
+        b.incrementBackoff();
+        CHECK(a.getBackoffTime() == b.getBackoffTime());
+    }
+}
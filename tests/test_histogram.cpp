@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/latency_histogram.h"
+
+namespace {
+
+// Within one sub-bucket (1/64 of the value) plus the microsecond rounding
+// applied on record
+void checkPercentiles(const std::vector<double>& values) {
+    LatencyHistogram histogram;
+    for (double v : values) histogram.record(v);
+    std::vector<double> sorted = values;
+    std::sort(sorted.begin(), sorted.end());
+
+    for (double p : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        double exact = sorted[std::max<size_t>(rank, 1) - 1];
+        double estimate = histogram.percentile(p);
+        if (std::fabs(estimate - exact) > exact / 64.0 + 0.0005) {
+            reportFailure(__FILE__, __LINE__, "p" + std::to_string(p) + " = " + std::to_string(estimate)
+                                                  + ", exact " + std::to_string(exact));
+        }
+    }
+    CHECK(histogram.count() == values.size());
+    CHECK(std::fabs(histogram.max() - sorted.back()) <= 0.0005);
+}
+
+} // namespace
+
+TEST(histogram_percentiles_of_a_uniform_distribution) {
+    std::vector<double> values;
+    for (int i = 1; i <= 100000; ++i) values.push_back(i * 0.01); // 0.01 .. 1000 ms
+    checkPercentiles(values);
+}
+
+TEST(histogram_percentiles_of_an_exponential_distribution) {
+    // Evenly spaced quantiles of an exponential with a 2 ms mean, so the
+    // long tail spans many powers of two
+    std::vector<double> values;
+    const int n = 50000;
+    for (int i = 0; i < n; ++i) values.push_back(-2.0 * std::log(1.0 - (i + 0.5) / n));
+    checkPercentiles(values);
+}
+
+TEST(histogram_small_values_are_exact) {
+    // Below 128 us every microsecond has its own bucket
+    LatencyHistogram histogram;
+    for (int us = 1; us <= 100; ++us) histogram.record(us / 1000.0);
+    CHECK(histogram.percentile(50.0) == 0.05);
+    CHECK(histogram.percentile(99.0) == 0.099);
+    CHECK_NEAR(histogram.mean(), 0.0505, 1e-12);
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/scenario.h"
+#include "../include/wifi4.h"
+#include "../include/wifi5.h"
+#include "../include/wifi6.h"
+
+// Properties every run must satisfy whatever the load: nothing is on air
+// after the run ends, the serial WiFi 4 medium is never double-booked, and
+// a single channel never carries more than its PHY rate.
+
+namespace {
+
+const double EPSILON = 1e-9;
+
+template <typename AP, typename StationUser>
+std::unique_ptr<AP> simulate(const ScenarioConfig& config, int numUsers) {
+    auto ap = std::make_unique<AP>(1);
+    ap->setProtocolParams(config.params);
+    ap->setQueueConfig(config.queue);
+    for (int i = 0; i < numUsers; ++i) ap->addUser(std::make_unique<StationUser>(i, config.params.packetSize));
+    if (config.mobility.enabled) {
+        ap->setMobility(std::make_unique<MobilityModel>(config.mobility, static_cast<size_t>(numUsers)));
+    }
+    ap->simulateTransmission();
+    return ap;
+}
+
+// Rate of one station holding the whole channel at the configured MCS, in Mbps
+double phyRate(const ProtocolParams& params) {
+    Packet packet(params.packetSize);
+    double airtime = packet.calculateTransmissionTime(params.bandwidth, params.modulationBits, params.codingRate);
+    return params.packetSize * 8 / (airtime * 1000.0);
+}
+
+void checkWithinRun(const AccessPoint& ap, double duration) {
+    for (const auto& packet : ap.getTransmittedPackets()) {
+        CHECK(packet->getTransmissionStartTime() >= 0.0);
+        CHECK(packet->getTransmissionEndTime() >= packet->getTransmissionStartTime());
+        CHECK(packet->getTransmissionEndTime() <= duration + EPSILON);
+    }
+}
+
+void checkSerialMedium(const AccessPoint& ap, double duration) {
+    std::vector<std::pair<double, double>> onAir;
+    for (const auto& packet : ap.getTransmittedPackets()) {
+        onAir.emplace_back(packet->getTransmissionStartTime(), packet->getTransmissionEndTime());
+    }
+    std::sort(onAir.begin(), onAir.end());
+    double busy = 0.0;
+    for (size_t i = 0; i < onAir.size(); ++i) {
+        busy += onAir[i].second - onAir[i].first;
+        if (i > 0) CHECK(onAir[i].first >= onAir[i - 1].second - EPSILON);
+    }
+    CHECK(busy <= duration + EPSILON);
+}
+
+std::vector<ScenarioConfig> scenarios() {
+    std::vector<ScenarioConfig> configs(4);
+    configs[1].mobility.enabled = true;
+    configs[1].mobility.pattern = MobilityPattern::RandomWaypoint;
+    configs[2].queue.aqm = AqmMode::CoDel;
+    configs[2].queue.uplinkRate = 0.5;
+    configs[3].params.duration = 333.3;
+    configs[3].params.packetSize = 1500;
+    configs[3].params.bandwidth = 40;
+    return configs;
+}
+
+} // namespace
+
+TEST(invariant_wifi4_airtime_fits_run) {
+    for (ScenarioConfig config : scenarios()) {
+        config.queue.downlinkRate = 0.1; // the AP contends for the same medium
+        for (int users : {1, 10, 100}) {
+            auto ap = simulate<WiFi4AccessPoint, WiFi4User>(config, users);
+            checkWithinRun(*ap, config.params.duration);
+            checkSerialMedium(*ap, config.params.duration);
+        }
+    }
+}
+
+TEST(invariant_wifi4_throughput_below_phy_rate) {
+    for (const ScenarioConfig& config : scenarios()) {
+        for (int users : {1, 10, 100}) {
+            auto ap = simulate<WiFi4AccessPoint, WiFi4User>(config, users);
+            CHECK(ap->computeThroughput() <= phyRate(config.params) + EPSILON);
+        }
+    }
+}
+
+TEST(invariant_wifi5_transmissions_end_in_run) {
+    for (const ScenarioConfig& config : scenarios()) {
+        for (int users : {1, 10, 100}) {
+            auto ap = simulate<WiFi5AccessPoint, WiFi5User>(config, users);
+            checkWithinRun(*ap, config.params.duration);
+        }
+    }
+}
+
+TEST(invariant_wifi6_transmissions_end_in_run) {
+    for (const ScenarioConfig& config : scenarios()) {
+        for (int users : {1, 10, 100}) {
+            auto ap = simulate<WiFi6AccessPoint, WiFi6User>(config, users);
+            checkWithinRun(*ap, config.params.duration);
+        }
+    }
+}
+
+TEST(invariant_wifi6_throughput_below_phy_rate) {
+    // Resource units share one channel, so their sum is capped by it
+    for (const ScenarioConfig& config : scenarios()) {
+        for (int users : {1, 10, 100}) {
+            auto ap = simulate<WiFi6AccessPoint, WiFi6User>(config, users);
+            CHECK(ap->computeThroughput() <= phyRate(config.params) + EPSILON);
+        }
+    }
+}
+
+TEST(invariant_idle_channel_skips_cycles) {
+    // Sparse arrivals: sounding and OFDMA windows only run when data waits
+    ScenarioConfig config;
+    config.params.duration = 3600000.0;
+    config.queue.uplinkRate = 0.00001;
+    const int users = 50;
+
+    auto wifi5 = simulate<WiFi5AccessPoint, WiFi5User>(config, users);
+    long offered = 0;
+    for (const auto& user : wifi5->getUsers()) offered += user->getUplinkQueue().getEnqueued();
+    long soundings = 0;
+    for (const auto& packet : wifi5->getTransmittedPackets()) {
+        if (packet->getDestinationId() == -1) ++soundings;
+    }
+    CHECK(offered > 0);
+    CHECK(soundings <= offered);
+
+    auto wifi6 = simulate<WiFi6AccessPoint, WiFi6User>(config, users);
+    CHECK(static_cast<long>(wifi6->getTransmittedPackets().size()) <= offered);
+    for (const auto& packet : wifi6->getTransmittedPackets()) {
+        double windows = packet->getTransmissionStartTime() / config.params.allocationTime;
+        CHECK(std::fabs(windows - std::round(windows)) < 1e-6);
+    }
+}
+
+TEST(invariant_unreachable_stations_do_not_stall) {
+    // Every link is out of range while the AP still has downlink traffic
+    // queued for it; idle jumps must keep moving time forward
+    ScenarioConfig config;
+    config.queue.downlinkRate = 0.1;
+    config.mobility.enabled = true;
+    config.mobility.txPower = -100.0;
+    const int users = 2;
+
+    auto wifi4 = simulate<WiFi4AccessPoint, WiFi4User>(config, users);
+    auto wifi5 = simulate<WiFi5AccessPoint, WiFi5User>(config, users);
+    auto wifi6 = simulate<WiFi6AccessPoint, WiFi6User>(config, users);
+    for (const auto& user : wifi4->getUsers()) CHECK(!user->getLink().usable);
+    CHECK(wifi4->getTransmittedPackets().empty());
+    CHECK(wifi5->getTransmittedPackets().empty());
+    CHECK(wifi6->getTransmittedPackets().empty());
+}
+
+TEST(invariant_wifi6_saturated_rus_use_the_channel) {
+    // Granted RUs carry back-to-back packets for the whole window, so a
+    // saturated cell uses most of the channel rather than one packet per RU
+    ScenarioConfig config;
+    for (int users : {10, 100}) {
+        auto ap = simulate<WiFi6AccessPoint, WiFi6User>(config, users);
+        CHECK(ap->computeThroughput() >= 0.5 * phyRate(config.params));
+        for (const auto& packet : ap->getTransmittedPackets()) {
+            double windowStart = std::floor(packet->getTransmissionStartTime() / config.params.allocationTime + 1e-9)
+                                 * config.params.allocationTime;
+            CHECK(packet->getTransmissionEndTime() <= windowStart + config.params.allocationTime + EPSILON);
+        }
+    }
+}
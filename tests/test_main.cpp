@@ -0,0 +1,52 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "./test_framework.h"
+
+namespace {
+int failures = 0;
+}
+
+std::vector<TestCase>& testRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+TestOptions& testOptions() {
+    static TestOptions options;
+    return options;
+}
+
+void reportFailure(const char* file, int line, const std::string& message) {
+    std::cerr << file << ":" << line << ": check failed: " << message << "\n";
+    ++failures;
+}
+
+// Usage: run_tests [--record-perf-baseline] [--perf-baseline PATH]
+//                  [--perf-tolerance FRACTION] [name-filter]
+int main(int argc, char* argv[]) {
+    TestOptions& options = testOptions();
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record-perf-baseline") options.recordPerfBaseline = true;
+        else if (arg == "--perf-baseline" && i + 1 < argc) options.perfBaselinePath = argv[++i];
+        else if (arg == "--perf-tolerance" && i + 1 < argc) options.perfTolerance = std::atof(argv[++i]);
+        else filter = arg;
+    }
+    if (options.recordPerfBaseline) filter = "perf";
+
+    int run = 0, failed = 0;
+    for (const TestCase& test : testRegistry()) {
+        if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) continue;
+        int before = failures;
+        test.body();
+        ++run;
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        std::cout << (passed ? "[ PASS ] " : "[ FAIL ] ") << test.name << "\n";
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed\n";
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "./test_framework.h"
+#include "../include/metrics.h"
+#include "../include/simulation.h"
+#include <unistd.h>
+
+namespace {
+
+// Value of an unlabelled sample in a Prometheus text file, or -1
+double sample(const std::string& text, const std::string& name) {
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.compare(0, name.size() + 1, name + " ") == 0) return std::stod(line.substr(name.size() + 1));
+    }
+    return -1.0;
+}
+
+} // namespace
+
+TEST(metrics_runs_publish_progress) {
+    SimulationMetrics& metrics = simulationMetrics();
+    uint64_t completed = metrics.scenariosCompleted.load();
+    uint64_t events = metrics.events.load();
+    uint64_t simulated = metrics.simulatedMicros.load();
+
+    ScenarioConfig config;
+    StationTable stations;
+    ProtocolResult r = runProtocol("wifi4", config, stations, 10);
+
+    CHECK(metrics.scenariosCompleted.load() == completed + 1);
+    CHECK(metrics.events.load() - events == r.packets);
+    CHECK(metrics.simulatedMicros.load() - simulated == 1000000);
+    CHECK(metrics.activeRuns.load() == 0);
+}
+
+TEST(metrics_progress_is_published_during_a_run) {
+    SimulationMetrics& metrics = simulationMetrics();
+    uint64_t events = metrics.events.load();
+    uint64_t simulated = metrics.simulatedMicros.load();
+    {
+        RunProgress progress;
+        // One round with many transmissions, like sounding a large cell
+        progress.update(100000, 2.0);
+        CHECK(metrics.events.load() - events == 100000);
+        CHECK(metrics.simulatedMicros.load() - simulated == 2000);
+
+        // Rounds that transmit nothing still report simulated time eventually
+        for (int round = 1; round <= 100000; ++round) progress.update(100000, 2.0 + round);
+        CHECK(metrics.simulatedMicros.load() - simulated > 2000);
+        CHECK(metrics.activeRuns.load() >= 1);
+    }
+}
+
+TEST(metrics_exporter_writes_snapshot) {
+    const std::string path = (std::filesystem::temp_directory_path()
+                              / ("wifi_sim_metrics_test_" + std::to_string(getpid()) + ".prom")).string();
+    {
+        MetricsExporter exporter(path, 0.01);
+        ScenarioConfig config;
+        StationTable stations;
+        runProtocol("wifi6", config, stations, 10);
+    }
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    std::remove(path.c_str());
+
+    CHECK(text.str().find("# TYPE wifi_sim_events_total counter") != std::string::npos);
+    CHECK(sample(text.str(), "wifi_sim_events_total") >= 602);
+    CHECK(sample(text.str(), "wifi_sim_scenarios_completed_total") >= 1);
+    CHECK(sample(text.str(), "wifi_sim_active_runs") == 0);
+    CHECK(sample(text.str(), "wifi_sim_resident_memory_bytes") > 0);
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/mobility.h"
+
+namespace {
+
+int cellOf(const MobilityConfig& config, double x, double y) {
+    int columns = static_cast<int>(std::ceil(config.areaWidth / config.gridCellSize));
+    int rows = static_cast<int>(std::ceil(config.areaHeight / config.gridCellSize));
+    int cx = std::clamp(static_cast<int>(x / config.gridCellSize), 0, columns - 1);
+    int cy = std::clamp(static_cast<int>(y / config.gridCellSize), 0, rows - 1);
+    return cy * columns + cx;
+}
+
+} // namespace
+
+TEST(mobility_cell_crossings_refresh_the_crowd_around_them) {
+    MobilityConfig config;
+    config.enabled = true;
+    config.pattern = MobilityPattern::RandomWaypoint;
+    config.speed = 5.0;          // 0.5 m per update
+    config.gridCellSize = 5.0;
+    config.interferenceRadius = 5.0;
+    const size_t stations = 200;
+    MobilityModel model(config, stations);
+    model.evaluateAllLinks();
+
+    std::vector<double> fromX(stations), fromY(stations);
+    size_t crossings = 0;
+    for (int step = 0; step < 100; ++step) {
+        for (size_t i = 0; i < stations; ++i) {
+            fromX[i] = model.getX(i);
+            fromY[i] = model.getY(i);
+        }
+        model.advanceTo(model.nextUpdateTime());
+        const std::vector<size_t>& changed = model.changedStations();
+        std::set<size_t> refreshed(changed.begin(), changed.end());
+
+        // Everyone within interference range of where a crosser left or
+        // arrived has its link recomputed in the same update
+        for (size_t i = 0; i < stations; ++i) {
+            if (cellOf(config, fromX[i], fromY[i]) == cellOf(config, model.getX(i), model.getY(i))) continue;
+            ++crossings;
+            CHECK(refreshed.count(i) == 1);
+            for (size_t j = 0; j < stations; ++j) {
+                if (j == i) continue;
+                double r2 = config.interferenceRadius * config.interferenceRadius;
+                double ox = model.getX(j) - fromX[i], oy = model.getY(j) - fromY[i];
+                double nx = model.getX(j) - model.getX(i), ny = model.getY(j) - model.getY(i);
+                if (ox * ox + oy * oy <= r2 || nx * nx + ny * ny <= r2) CHECK(refreshed.count(j) == 1);
+            }
+        }
+
+        // A recomputed link reflects the crowd as it is now
+        std::vector<size_t> crowd;
+        for (size_t i : changed) {
+            model.neighbours(i, config.interferenceRadius, crowd);
+            double distance = std::max(1.0, std::hypot(model.getX(i) - config.apX, model.getY(i) - config.apY));
+            double pathLoss = config.referenceLoss + 10.0 * config.pathLossExponent * std::log10(distance);
+            double noiseRise = 10.0 * std::log10(1.0 + config.interferenceFactor * crowd.size());
+            CHECK_NEAR(model.link(i).snrDb, config.txPower - pathLoss - config.noiseFloor - noiseRise, 1e-9);
+        }
+    }
+    CHECK(crossings > 100);
+}
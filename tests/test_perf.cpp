@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "./test_framework.h"
+#include "../include/simulation.h"
+
+// Guards simulator speed: the event rate (transmissions simulated per
+// wall-clock second) of a fixed workload must stay within the tolerance of
+// the rate stored in the baseline file.
+
+namespace {
+
+const int REPETITIONS = 3;
+
+// Best of several runs, to keep scheduler noise out of the measurement
+double measureEventRate() {
+    ScenarioConfig config;
+    config.params.duration = 20000.0;
+    StationTable stations;
+    double best = 0.0;
+    for (int rep = 0; rep < REPETITIONS; ++rep) {
+        size_t events = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& name : config.accessPoints) {
+            events += runProtocol(name, config, stations, 100).packets;
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max(best, events / elapsed.count());
+    }
+    return best;
+}
+
+bool readBaseline(const std::string& path, double& rate) {
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        return std::sscanf(line.c_str(), "events_per_second %lf", &rate) == 1;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(perf_event_rate) {
+    const TestOptions& options = testOptions();
+    double rate = measureEventRate();
+    std::cout << "  event rate: " << static_cast<long long>(rate) << " events/s\n";
+
+    if (options.recordPerfBaseline) {
+        std::ofstream out(options.perfBaselinePath);
+        out << "# Written by 'make perf-baseline'; checked by 'make test'\n"
+            << "events_per_second " << static_cast<long long>(rate) << "\n";
+        CHECK(out.good());
+        return;
+    }
+
+    double baseline = 0.0;
+    if (!readBaseline(options.perfBaselinePath, baseline)) {
+        reportFailure(__FILE__, __LINE__, "no baseline in " + options.perfBaselinePath + "; run 'make perf-baseline'");
+        return;
+    }
+    std::cout << "  baseline:   " << static_cast<long long>(baseline) << " events/s\n";
+    CHECK(rate >= baseline * (1.0 - options.perfTolerance));
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <set>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/wifi5.h"
+#include "../include/wifi6.h"
+
+// Access points composed from policies other than the three built-in ones
+
+namespace {
+
+template <typename AP, typename StationUser>
+std::unique_ptr<AP> simulate(const ProtocolParams& params, int numUsers,
+                             std::unique_ptr<MobilityModel> mobility = nullptr) {
+    auto ap = std::make_unique<AP>(1);
+    ap->setProtocolParams(params);
+    for (int i = 0; i < numUsers; ++i) ap->addUser(std::make_unique<StationUser>(i, params.packetSize));
+    if (mobility) ap->setMobility(std::move(mobility));
+    ap->simulateTransmission();
+    return ap;
+}
+
+// Static stations on two rings around the AP: even ones 10 m out, well
+// inside beamforming range, odd ones 30 m out, reachable at a low MCS but
+// below beamforming_snr
+std::unique_ptr<MobilityModel> twoRings(int numUsers) {
+    MobilityConfig config;
+    config.enabled = true;
+    auto model = std::make_unique<MobilityModel>(config, static_cast<size_t>(numUsers));
+    for (int i = 0; i < numUsers; ++i) {
+        double angle = 2.0 * M_PI * i / numUsers;
+        double radius = i % 2 == 0 ? 10.0 : 30.0;
+        model->placeStation(i, config.apX + radius * std::cos(angle), config.apY + radius * std::sin(angle));
+    }
+    return model;
+}
+
+// Stations that delivered at least one data packet
+std::set<int> dataSenders(const AccessPoint& ap, int packetSize) {
+    std::set<int> senders;
+    for (const auto& packet : ap.getTransmittedPackets()) {
+        if (packet->getDestinationId() != -1 && packet->getSize() == packetSize) senders.insert(packet->getSourceId());
+    }
+    return senders;
+}
+
+// Most distinct stations sending data between two soundings
+size_t maxStationsPerCycle(const AccessPoint& ap, int packetSize) {
+    std::vector<const Packet*> packets;
+    for (const auto& packet : ap.getTransmittedPackets()) packets.push_back(packet.get());
+    std::stable_sort(packets.begin(), packets.end(), [](const Packet* a, const Packet* b) {
+        return a->getTransmissionStartTime() < b->getTransmissionStartTime();
+    });
+
+    size_t most = 0;
+    std::set<int> senders;
+    for (const Packet* packet : packets) {
+        if (packet->getDestinationId() == -1) {
+            senders.clear(); // sounding opens a new cycle
+        } else if (packet->getSize() == packetSize) {
+            senders.insert(packet->getSourceId());
+            most = std::max(most, senders.size());
+        }
+    }
+    return most;
+}
+
+} // namespace
+
+TEST(policy_hybrid_sounds_then_splits_window_into_rus) {
+    ProtocolParams params;
+    const int users = 20;
+    auto hybrid = simulate<WiFi6MuMimoAccessPoint, WiFi6User>(params, users, twoRings(users));
+    auto muMimo = simulate<WiFi5AccessPoint, WiFi5User>(params, users, twoRings(users));
+    auto ofdma = simulate<WiFi6AccessPoint, WiFi6User>(params, users, twoRings(users));
+
+    // Same sounding as MU-MIMO...
+    size_t soundings = 0;
+    for (const auto& packet : hybrid->getTransmittedPackets()) {
+        if (packet->getDestinationId() == -1) ++soundings;
+    }
+    CHECK(soundings > 0);
+    for (const auto& user : hybrid->getUsers()) {
+        CHECK(user->getLink().usable);
+        CHECK(user->getLink().beamformable == (user->getId() % 2 == 0));
+    }
+
+    // ...so only the stations the AP can steer a beam to are granted RUs,
+    // while plain OFDMA, which does not sound, serves every station
+    std::set<int> hybridSenders = dataSenders(*hybrid, params.packetSize);
+    CHECK(!hybridSenders.empty());
+    for (int id : hybridSenders) CHECK(id % 2 == 0);
+    CHECK(dataSenders(*muMimo, params.packetSize) == hybridSenders);
+    CHECK(dataSenders(*ofdma, params.packetSize).size() == static_cast<size_t>(users));
+
+    // ...and only as many stations per window as resource units fit the channel
+    int smallestRu = *std::min_element(params.subChannelSizes.begin(), params.subChannelSizes.end());
+    size_t ruLimit = static_cast<size_t>(params.bandwidth / smallestRu);
+    size_t hybridStations = maxStationsPerCycle(*hybrid, params.packetSize);
+    CHECK(hybridStations > 0);
+    CHECK(hybridStations <= ruLimit);
+    CHECK(maxStationsPerCycle(*muMimo, params.packetSize) == static_cast<size_t>(users / 2));
+}
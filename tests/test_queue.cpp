@@ -0,0 +1,78 @@
+#include <cmath>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/packet_queue.h"
+#include "../include/ring_buffer.h"
+
+TEST(queue_ring_buffer_wraps_around_in_fifo_order) {
+    RingBuffer<int> ring(4);
+    CHECK(ring.empty());
+    CHECK(ring.capacity() == 4);
+
+    // Keep three values queued while pushing well past the capacity, so
+    // both ends wrap many times
+    int pushed = 0, popped = 0;
+    for (; pushed < 3; ++pushed) CHECK(ring.push(pushed));
+    for (int round = 0; round < 20; ++round) {
+        CHECK(ring.push(pushed++));
+        CHECK(ring.full());
+        CHECK(!ring.push(-1));
+        CHECK(ring.front() == popped);
+        ring.pop();
+        ++popped;
+        CHECK(ring.size() == 3);
+    }
+    while (!ring.empty()) {
+        CHECK(ring.front() == popped++);
+        ring.pop();
+    }
+    CHECK(popped == pushed);
+}
+
+TEST(queue_codel_drops_on_the_control_law_schedule) {
+    QueueConfig config;
+    config.capacity = 400;
+    config.aqm = AqmMode::CoDel;
+    const double step = 0.5; // ms between services
+
+    // A saturated source served every 0.5 ms: the head's sojourn time
+    // reaches the 5 ms target at t = 5 and then only grows
+    PacketQueue queue(config, SATURATED);
+    std::vector<double> drops;
+    for (int i = 0; i <= 2000; ++i) {
+        double now = i * step;
+        queue.offer(now, 1024, 0, 1);
+        long before = queue.getAqmDrops();
+        QueuedPacket packet;
+        CHECK(queue.dequeue(now, packet));
+        if (queue.getAqmDrops() > before) drops.push_back(now);
+    }
+
+    // First drop once the sojourn has stayed above target for a full
+    // interval; the k-th drop after it follows interval / sqrt(k)
+    CHECK(drops.size() > 10);
+    double expected = 5.0 + config.codelInterval;
+    for (size_t k = 0; k < drops.size(); ++k) {
+        if (k > 0) expected += config.codelInterval / std::sqrt(static_cast<double>(k));
+        CHECK(drops[k] >= expected - 1e-9);
+        CHECK(drops[k] < expected + step);
+    }
+    CHECK(queue.getAqmDrops() == static_cast<long>(drops.size()));
+}
+
+TEST(queue_codel_leaves_short_queues_alone) {
+    QueueConfig config;
+    config.aqm = AqmMode::CoDel;
+
+    // One arrival every 2 ms, served every millisecond: no packet waits
+    // anywhere near the target
+    PacketQueue queue(config, 0.5);
+    for (int now = 0; now <= 2000; ++now) {
+        queue.offer(now, 1024, 0, 1);
+        QueuedPacket packet;
+        queue.dequeue(now, packet);
+    }
+    CHECK(queue.getEnqueued() == 1001);
+    CHECK(queue.getAqmDrops() == 0);
+    CHECK(queue.getTailDrops() == 0);
+}
@@ -0,0 +1,87 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "./test_framework.h"
+#include "../include/result_cache.h"
+#include <unistd.h>
+
+namespace {
+
+std::filesystem::path cacheDirectory() {
+    return std::filesystem::temp_directory_path() / ("wifi_sim_cache_test_" + std::to_string(getpid()));
+}
+
+ProtocolResult sampleResult() {
+    ProtocolResult r{};
+    r.throughput = 105.054208;
+    r.avgLatency = 0.230735371;
+    r.maxLatency = 0.6144;
+    r.queueP50 = 49.877;
+    r.queueP99 = 499.877;
+    r.packets = 12824;
+    return r;
+}
+
+bool sameResult(const ProtocolResult& a, const ProtocolResult& b) {
+    return a.throughput == b.throughput && a.avgLatency == b.avgLatency && a.maxLatency == b.maxLatency
+           && a.queueP50 == b.queueP50 && a.queueP99 == b.queueP99 && a.packets == b.packets;
+}
+
+} // namespace
+
+TEST(result_cache_round_trips_and_reloads_its_index) {
+    const std::filesystem::path dir = cacheDirectory();
+    std::filesystem::remove_all(dir);
+    const uint64_t key = ResultCache::makeKey("users=10;ap=wifi6");
+    const uint64_t other = ResultCache::makeKey("users=10;ap=wifi5");
+    CHECK(key != other);
+
+    {
+        ResultCache cache(dir.string());
+        ProtocolResult r{};
+        CHECK(!cache.lookup(key, r));
+        cache.store(key, sampleResult());
+        CHECK(cache.lookup(key, r));
+        CHECK(sameResult(r, sampleResult()));
+        CHECK(!cache.lookup(other, r));
+    }
+
+    // A fresh cache finds the entry through the index written by the first
+    ResultCache reopened(dir.string());
+    CHECK(reopened.size() == 1);
+    ProtocolResult r{};
+    CHECK(reopened.lookup(key, r));
+    CHECK(sameResult(r, sampleResult()));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(result_cache_rejects_corrupt_entries) {
+    const std::filesystem::path dir = cacheDirectory();
+    std::filesystem::remove_all(dir);
+    const uint64_t key = ResultCache::makeKey("users=1;ap=wifi4");
+
+    ResultCache cache(dir.string());
+    cache.store(key, sampleResult());
+    std::filesystem::path entry;
+    for (const auto& file : std::filesystem::directory_iterator(dir)) {
+        if (file.path().extension() == ".bin") entry = file.path();
+    }
+    CHECK(!entry.empty());
+
+    // Overwrite the magic number
+    {
+        std::fstream out(entry, std::ios::binary | std::ios::in | std::ios::out);
+        out.write("XXXX", 4);
+    }
+    ProtocolResult r{};
+    CHECK(!cache.lookup(key, r));
+
+    // A torn entry, header intact but record cut short
+    cache.store(key, sampleResult());
+    CHECK(cache.lookup(key, r));
+    std::filesystem::resize_file(entry, std::filesystem::file_size(entry) - 8);
+    CHECK(!cache.lookup(key, r));
+
+    std::filesystem::remove_all(dir);
+}
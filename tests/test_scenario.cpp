@@ -0,0 +1,140 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "./test_framework.h"
+#include "../include/scenario.h"
+#include "../include/station_table.h"
+#include <unistd.h>
+
+namespace {
+
+// Per-process name, so concurrent test runs never share a file
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / (name + "_" + std::to_string(getpid()))).string();
+}
+
+// Convert `csv` through a temporary file; returns the converter's verdict
+bool convert(const std::string& csv, std::string& error, StationTable* table = nullptr) {
+    std::string csvPath = tempPath("wifi_sim_test_stations") + ".csv";
+    std::string binPath = tempPath("wifi_sim_test_stations") + ".bin";
+    std::ofstream(csvPath) << csv;
+    bool ok = convertStationTable(csvPath, binPath, error);
+    if (ok && table) ok = table->open(binPath, error);
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(binPath); // an open table keeps its mapping
+    return ok;
+}
+
+// Load `ini` on top of the defaults through a temporary file
+bool load(const std::string& ini, ScenarioConfig& config, std::string& error) {
+    std::string path = tempPath("wifi_sim_test_scenario") + ".ini";
+    std::ofstream(path) << ini;
+    bool ok = loadScenario(path, config, error);
+    std::filesystem::remove(path);
+    return ok;
+}
+
+} // namespace
+
+TEST(scenario_description_keeps_full_precision) {
+    ScenarioConfig a, b;
+    a.params.duration = 3600000.0;
+    b.params.duration = 3600004.0;
+    CHECK(describeScenario(a, "wifi4") != describeScenario(b, "wifi4"));
+
+    a = b = ScenarioConfig();
+    a.queue.uplinkRate = 0.1234561;
+    b.queue.uplinkRate = 0.1234564;
+    CHECK(describeScenario(a, "wifi4") != describeScenario(b, "wifi4"));
+
+    a = b = ScenarioConfig();
+    a.mobility.enabled = b.mobility.enabled = true;
+    a.mobility.speed = 1.4;
+    b.mobility.speed = 1.4000001;
+    CHECK(describeScenario(a, "wifi4") != describeScenario(b, "wifi4"));
+    CHECK(describeScenario(a, "wifi4") == describeScenario(a, "wifi4"));
+}
+
+TEST(scenario_description_covers_only_the_protocols_settings) {
+    ScenarioConfig a, b;
+    b.params.allocationTime = 2.5;
+    CHECK(describeScenario(a, "wifi4") == describeScenario(b, "wifi4"));
+    CHECK(describeScenario(a, "wifi5") == describeScenario(b, "wifi5"));
+    CHECK(describeScenario(a, "wifi6") != describeScenario(b, "wifi6"));
+
+    a = b = ScenarioConfig();
+    b.params.csiSize = 512;
+    CHECK(describeScenario(a, "wifi4") == describeScenario(b, "wifi4"));
+    CHECK(describeScenario(a, "wifi5") != describeScenario(b, "wifi5"));
+    CHECK(describeScenario(a, "wifi6") == describeScenario(b, "wifi6"));
+
+    // Shared settings reach every protocol
+    a = b = ScenarioConfig();
+    b.params.packetSize = 512;
+    for (const char* name : {"wifi4", "wifi5", "wifi6"}) CHECK(describeScenario(a, name) != describeScenario(b, name));
+    CHECK(describeScenario(a, "wifi4") != describeScenario(a, "wifi5"));
+}
+
+TEST(scenario_station_csv_is_parsed_strictly) {
+    std::string error;
+    StationTable table;
+    CHECK(convert("# id, size, uplink, downlink, x, y\n1, 1500, saturated, 0.5\n2, 0, 0.25, 0, 10, 20\n", error, &table));
+    CHECK(table.size() == 2);
+    CHECK(table[0].packetSize == 1500);
+    CHECK(table[0].uplinkRate == static_cast<float>(SATURATED));
+    CHECK(table[1].x == 10.0f);
+
+    const char* invalid[] = {
+        "1, big, 0.5, 0\n",          // packet size not a number
+        "1, 1024, fast, 0\n",        // rate not a number
+        "1, 1024, -0.5, 0\n",        // negative rate
+        "1, 1024, 0.5, 0.1x\n",      // trailing garbage
+        "x1, 1024, 0.5, 0\n",        // id not a number
+        "1, 1024, 0.5, 0, 3, nan\n", // position not finite
+        "1, 1024, 0.5, 0, 3\n",      // five fields
+        "1, 1024, 0.5, 0,\n",        // trailing separator
+        "1, 1024, 0.5, 0, 1, 2, 99, garbage\n", // extra fields
+    };
+    for (const char* csv : invalid) {
+        error.clear();
+        CHECK(!convert(std::string("2, 1024, 0.5, 0\n") + csv, error));
+        CHECK(error.find(".csv:2:") != std::string::npos);
+    }
+}
+
+TEST(scenario_values_must_be_finite_and_in_range) {
+    ScenarioConfig config;
+    std::string error;
+    CHECK(load("[simulation]\nusers = 5, 50\n[phy]\ncoding_rate = 3/4\n[wifi6]\nsub_channels = 4, 8\n", config, error));
+    CHECK(config.userCounts == std::vector<int>({5, 50}));
+    CHECK(config.params.codingRate == 0.75);
+    CHECK(config.params.subChannelSizes == std::vector<int>({4, 8}));
+
+    const char* invalid[] = {
+        "[simulation]\nduration = inf\n",
+        "[simulation]\nduration = nan\n",
+        "[simulation]\nusers = 0, -5\n",
+        "[simulation]\nusers = 10, 0\n",
+        "[wifi6]\nsub_channels = -4\n",
+        "[wifi6]\nsub_channels = 2, 0\n",
+        "[wifi5]\nparallel_window = 1e999\n",
+        "[phy]\ncoding_rate = 5/0\n",
+        "[phy]\ncoding_rate = 7/6\n",
+        "[mobility]\ntx_power = -inf\n",
+        "[traffic]\nuplink_rate = inf\n",
+    };
+    for (const char* ini : invalid) {
+        config = ScenarioConfig();
+        CHECK(!load(ini, config, error));
+    }
+}
+
+TEST(scenario_default_file_reproduces_the_built_in_defaults) {
+    ScenarioConfig config;
+    std::string error;
+    CHECK(loadScenario("scenarios/default.ini", config, error));
+    for (const char* name : {"wifi4", "wifi5", "wifi6"}) {
+        CHECK(describeScenario(config, name) == describeScenario(ScenarioConfig(), name));
+    }
+}